@@ -0,0 +1,298 @@
+// Harness de benchmarks compartido por memoria_cache/ y py/.
+//
+// - Corridas de calentamiento antes de medir
+// - Repeticiones adaptativas: se mide hasta que el intervalo de confianza
+//   del 95% de la media es menor que target_ci (relativo) o se agota el
+//   presupuesto de tiempo / repeticiones
+// - Estadísticos: mediana, p5, p95, mínimo, media y desviación estándar
+// - Fijación opcional a una CPU durante la medición
+// - Barrera do_not_optimize para que el compilador no elimine el kernel
+// - Todas las mediciones se acumulan en un reporte que se escribe en JSON o
+//   CSV (según la extensión) si PARALELA_BENCH_OUTPUT está definida, junto
+//   con la variante ISA de los kernels (cpu_dispatch.hpp)
+//
+// Variables de entorno (sobrescriben los valores por defecto):
+//   PARALELA_BENCH_WARMUP, PARALELA_BENCH_MIN_REPS, PARALELA_BENCH_MAX_REPS,
+//   PARALELA_BENCH_MAX_TIME (s), PARALELA_BENCH_CI (p.ej. 0.02),
+//   PARALELA_BENCH_PIN_CPU (-1 = sin fijar), PARALELA_BENCH_OUTPUT
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "cpu_dispatch.hpp"
+
+// ============================================
+// BARRERAS PARA EL OPTIMIZADOR
+// ============================================
+// El valor se considera leído por código opaco: el cálculo que lo produce
+// no se puede eliminar
+template <typename T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Toda la memoria se considera leída y escrita: las escrituras del kernel
+// no se pueden eliminar ni mover fuera de la medición
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+// ============================================
+// CONFIGURACIÓN
+// ============================================
+struct BenchConfig {
+    int warmup = 1;           // corridas descartadas
+    int min_repeats = 3;
+    int max_repeats = 30;
+    double max_time = 2.0;    // s de medición por benchmark (sin calentamiento)
+    double target_ci = 0.02;  // semiancho del IC 95% / media
+    int pin_cpu = -1;         // los hilos que cree el kernel heredan la afinidad
+};
+
+inline double env_or(const char* name, double fallback) {
+    const char* value = std::getenv(name);
+    return value && *value ? std::atof(value) : fallback;
+}
+
+// Valores por defecto con las sobrescrituras del entorno (leídos una vez)
+inline const BenchConfig& default_bench_config() {
+    static const BenchConfig config = [] {
+        BenchConfig c;
+        c.warmup = static_cast<int>(env_or("PARALELA_BENCH_WARMUP", c.warmup));
+        c.min_repeats = std::max(1, static_cast<int>(env_or("PARALELA_BENCH_MIN_REPS", c.min_repeats)));
+        c.max_repeats = std::max(c.min_repeats,
+                                 static_cast<int>(env_or("PARALELA_BENCH_MAX_REPS", c.max_repeats)));
+        c.max_time = env_or("PARALELA_BENCH_MAX_TIME", c.max_time);
+        c.target_ci = env_or("PARALELA_BENCH_CI", c.target_ci);
+        c.pin_cpu = static_cast<int>(env_or("PARALELA_BENCH_PIN_CPU", c.pin_cpu));
+        return c;
+    }();
+    return config;
+}
+
+// Configuración para kernels largos o que no se pueden repetir sin costo
+// (demostraciones): sin calentamiento y una sola medición
+inline BenchConfig single_run_config() {
+    BenchConfig c = default_bench_config();
+    c.warmup = 0;
+    c.min_repeats = c.max_repeats = 1;
+    return c;
+}
+
+// ============================================
+// ESTADÍSTICOS
+// ============================================
+struct BenchStats {
+    std::string name;
+    int repeats = 0;
+    double median = 0.0, p5 = 0.0, p95 = 0.0, min = 0.0, max = 0.0;  // segundos
+    double mean = 0.0, stddev = 0.0;
+    double ci95 = 0.0;  // semiancho del IC 95% de la media, relativo a la media
+};
+
+// Percentil p en [0, 1] con interpolación lineal (sorted ya ordenado)
+inline double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.size() == 1) return sorted[0];
+    double pos = p * (sorted.size() - 1);
+    size_t lo = static_cast<size_t>(pos);
+    size_t hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+// t de Student bilateral al 95% con n - 1 grados de libertad
+inline double student_t95(size_t n) {
+    static const double table[] = {0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365,
+                                   2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+                                   2.120, 2.110, 2.101, 2.093, 2.086};
+    size_t df = n - 1;
+    if (df < sizeof(table) / sizeof(table[0])) return table[df];
+    return df < 30 ? 2.045 : 1.96;
+}
+
+inline double relative_ci95(const std::vector<double>& samples) {
+    size_t n = samples.size();
+    if (n < 2) return INFINITY;
+    double mean = 0.0, var = 0.0;
+    for (double s : samples) mean += s;
+    mean /= n;
+    for (double s : samples) var += (s - mean) * (s - mean);
+    var /= n - 1;
+    return student_t95(n) * std::sqrt(var / n) / mean;
+}
+
+inline BenchStats compute_stats(const std::string& name, std::vector<double> samples) {
+    BenchStats st;
+    st.name = name;
+    st.repeats = static_cast<int>(samples.size());
+    std::sort(samples.begin(), samples.end());
+    st.min = samples.front();
+    st.max = samples.back();
+    st.median = percentile(samples, 0.50);
+    st.p5 = percentile(samples, 0.05);
+    st.p95 = percentile(samples, 0.95);
+    for (double s : samples) st.mean += s;
+    st.mean /= samples.size();
+    for (double s : samples) st.stddev += (s - st.mean) * (s - st.mean);
+    st.stddev = samples.size() > 1 ? std::sqrt(st.stddev / (samples.size() - 1)) : 0.0;
+    st.ci95 = samples.size() > 1 ? relative_ci95(samples) : 0.0;
+    return st;
+}
+
+// ============================================
+// REPORTE (JSON / CSV)
+// ============================================
+inline std::vector<BenchStats>& bench_report() {
+    static std::vector<BenchStats> report;
+    return report;
+}
+
+inline std::string json_escape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// Campo CSV entre comillas; las comillas de adentro se duplican (RFC 4180)
+inline std::string csv_quote(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + '"';
+}
+
+inline void write_bench_csv(std::ostream& out, const std::vector<BenchStats>& report) {
+    out << "benchmark,repeticiones,mediana_s,p5_s,p95_s,min_s,max_s,media_s,desv_s,ic95_rel,isa\n";
+    for (const BenchStats& st : report) {
+        out << csv_quote(st.name) << ',' << st.repeats << ',' << st.median << ',' << st.p5 << ','
+            << st.p95 << ',' << st.min << ',' << st.max << ',' << st.mean << ','
+            << st.stddev << ',' << st.ci95 << ',' << isa_name(active_isa()) << '\n';
+    }
+}
+
+inline void write_bench_json(std::ostream& out, const std::string& program,
+                             const std::vector<BenchStats>& report) {
+    out << "{\n  \"programa\": \"" << json_escape(program) << "\",\n  \"isa\": \""
+        << isa_name(active_isa()) << "\",\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < report.size(); ++i) {
+        const BenchStats& st = report[i];
+        out << "    {\"nombre\": \"" << json_escape(st.name) << "\", \"repeticiones\": " << st.repeats
+            << ", \"mediana_s\": " << st.median << ", \"p5_s\": " << st.p5
+            << ", \"p95_s\": " << st.p95 << ", \"min_s\": " << st.min
+            << ", \"max_s\": " << st.max << ", \"media_s\": " << st.mean
+            << ", \"desv_s\": " << st.stddev << ", \"ic95_rel\": " << st.ci95 << "}"
+            << (i + 1 < report.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Escribe el reporte en $PARALELA_BENCH_OUTPUT (.json o .csv); sin la
+// variable no hace nada. Se llama al final de main.
+inline void save_bench_report(const std::string& program) {
+    const char* path = std::getenv("PARALELA_BENCH_OUTPUT");
+    if (!path || !*path) return;
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << path << " para escribir el reporte\n";
+        return;
+    }
+    file.precision(9);
+    std::string p(path);
+    if (p.size() >= 4 && p.compare(p.size() - 4, 4, ".csv") == 0)
+        write_bench_csv(file, bench_report());
+    else
+        write_bench_json(file, program, bench_report());
+    std::clog << "[bench] reporte guardado en " << path << "\n";
+}
+
+// ============================================
+// FIJACIÓN A UNA CPU
+// ============================================
+// Fija el hilo actual a `cpu` mientras vive el objeto y restaura la máscara
+// anterior al destruirse. cpu < 0 no hace nada.
+class CpuPin {
+    cpu_set_t previous_;
+    bool active_ = false;
+public:
+    explicit CpuPin(int cpu) {
+        if (cpu < 0) return;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(previous_), &previous_) != 0) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        active_ = pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+        if (!active_) std::clog << "[bench] no se pudo fijar a la CPU " << cpu << "\n";
+    }
+    ~CpuPin() {
+        if (active_) pthread_setaffinity_np(pthread_self(), sizeof(previous_), &previous_);
+    }
+    CpuPin(const CpuPin&) = delete;
+    CpuPin& operator=(const CpuPin&) = delete;
+};
+
+// ============================================
+// MEDICIÓN
+// ============================================
+// Mide `kernel`; `setup` corre antes de cada ejecución y queda fuera del
+// tiempo (p.ej. poner y = 0). El resultado se agrega a bench_report().
+template <typename Setup, typename Kernel>
+BenchStats run_benchmark_setup(const std::string& name, Setup&& setup, Kernel&& kernel,
+                               const BenchConfig& config = default_bench_config()) {
+    using clock = std::chrono::steady_clock;
+    CpuPin pin(config.pin_cpu);
+
+    auto timed_run = [&] {
+        setup();
+        clobber_memory();
+        auto start = clock::now();
+        kernel();
+        clobber_memory();
+        auto end = clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    };
+
+    // Calentamiento: un kernel más largo que el presupuesto no se repite
+    for (int i = 0; i < config.warmup; ++i) {
+        if (timed_run() >= config.max_time) break;
+    }
+
+    std::vector<double> samples;
+    double elapsed = 0.0;
+    while (true) {
+        double t = timed_run();
+        samples.push_back(t);
+        elapsed += t;
+
+        int n = static_cast<int>(samples.size());
+        if (n >= config.max_repeats) break;
+        // Por debajo de min_repeats no corta ni el tiempo: la mediana y la
+        // desviación necesitan esas muestras aunque el kernel sea lento
+        if (n < config.min_repeats) continue;
+        if (relative_ci95(samples) <= config.target_ci) break;
+        if (elapsed >= config.max_time) break;
+    }
+
+    BenchStats st = compute_stats(name, std::move(samples));
+    bench_report().push_back(st);
+    return st;
+}
+
+template <typename Kernel>
+BenchStats run_benchmark(const std::string& name, Kernel&& kernel,
+                         const BenchConfig& config = default_bench_config()) {
+    return run_benchmark_setup(name, [] {}, std::forward<Kernel>(kernel), config);
+}
@@ -0,0 +1,136 @@
+// Selección en tiempo de ejecución de la variante ISA de los kernels.
+//
+// Los kernels calientes se compilan en tres variantes dentro del mismo
+// binario: SSE2 (la base de x86-64, con los flags del build), AVX2+FMA y
+// AVX-512, estas dos con __attribute__((target)). Al primer uso se consulta
+// cpuid (y XCR0, para saber si el sistema operativo guarda los registros
+// YMM/ZMM) y se elige la más ancha disponible; así un binario compilado sin
+// -march=native sirve en cualquier máquina x86-64 y aprovecha la que tenga.
+//
+// PARALELA_ISA=sse2|avx2|avx512 fuerza una variante (si la CPU no la tiene
+// se avisa y se usa la mejor disponible). La elegida se informa una vez por
+// std::clog y queda en el reporte de benchmark.hpp.
+//
+// Patrón para un kernel con variantes: el cuerpo va en una función
+// ISA_INLINE y cada variante es un envoltorio con su ISA_TARGET_*, así el
+// compilador genera el cuerpo tres veces con instrucciones distintas. Los
+// kernels con intrínsecos escriben cada variante a mano; para los que solo
+// vectoriza el compilador, ISA_VARIANTS genera los envoltorios.
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <iostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#define ISA_X86 1
+#endif
+
+#define ISA_INLINE inline __attribute__((always_inline))
+#define ISA_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#define ISA_TARGET_AVX512 __attribute__((target("avx512f")))
+
+enum class Isa { SSE2, AVX2, AVX512 };
+
+inline const char* isa_name(Isa isa) {
+    switch (isa) {
+        case Isa::AVX512: return "avx512";
+        case Isa::AVX2: return "avx2";
+        default: return "sse2";
+    }
+}
+
+// ============================================
+// DETECCIÓN
+// ============================================
+#if defined(ISA_X86)
+inline uint64_t read_xcr0() {
+    uint32_t lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (uint64_t(hi) << 32) | lo;
+}
+#endif
+
+inline bool cpu_supports(Isa isa) {
+    if (isa == Isa::SSE2) return true;
+#if defined(ISA_X86)
+    unsigned a, b, c, d;
+    if (!__get_cpuid(1, &a, &b, &c, &d)) return false;
+    if (!(c & bit_OSXSAVE) || !(c & bit_AVX) || !(c & bit_FMA)) return false;
+    // El sistema debe guardar XMM y YMM (bits 1 y 2 de XCR0)
+    const uint64_t xcr0 = read_xcr0();
+    if ((xcr0 & 0x6) != 0x6) return false;
+    if (!__get_cpuid_count(7, 0, &a, &b, &c, &d)) return false;
+    if (isa == Isa::AVX2) return (b & bit_AVX2) != 0;
+    // AVX-512: además opmask y las dos mitades de los ZMM (bits 5, 6 y 7)
+    return (b & bit_AVX512F) && (xcr0 & 0xE0) == 0xE0;
+#else
+    return false;
+#endif
+}
+
+inline Isa best_supported_isa() {
+    if (cpu_supports(Isa::AVX512)) return Isa::AVX512;
+    if (cpu_supports(Isa::AVX2)) return Isa::AVX2;
+    return Isa::SSE2;
+}
+
+inline Isa select_isa() {
+    const Isa best = best_supported_isa();
+    const char* env = std::getenv("PARALELA_ISA");
+    if (!env || !*env) {
+        std::clog << "[isa] variante " << isa_name(best) << " (detectada con cpuid)\n";
+        return best;
+    }
+    for (Isa isa : {Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+        if (std::strcmp(env, isa_name(isa)) != 0) continue;
+        if (!cpu_supports(isa)) {
+            std::clog << "[isa] PARALELA_ISA=" << env << " no está soportada por esta CPU, se usa "
+                      << isa_name(best) << "\n";
+            return best;
+        }
+        std::clog << "[isa] variante " << isa_name(isa) << " (forzada con PARALELA_ISA)\n";
+        return isa;
+    }
+    std::clog << "[isa] PARALELA_ISA=" << env << " desconocida (sse2|avx2|avx512), se usa "
+              << isa_name(best) << "\n";
+    return best;
+}
+
+// Variante que usan todos los kernels; se decide una sola vez
+inline Isa active_isa() {
+    static const Isa isa = select_isa();
+    return isa;
+}
+
+// ============================================
+// VARIANTES
+// ============================================
+template <typename Fn>
+inline Fn isa_select(Fn sse2, Fn avx2, Fn avx512) {
+    switch (active_isa()) {
+        case Isa::AVX512: return avx512;
+        case Isa::AVX2: return avx2;
+        default: return sse2;
+    }
+}
+
+// ISA_VARIANTS(nombre, (parámetros), (argumentos)): a partir de nombre_body
+// define nombre_sse2, nombre_avx2, nombre_avx512 y nombre, que llama a la
+// variante activa. Para kernels que devuelven void.
+#if defined(ISA_X86)
+#define ISA_VARIANTS(name, params, args)                                         \
+    inline void name##_sse2 params { name##_body args; }                         \
+    ISA_TARGET_AVX2 inline void name##_avx2 params { name##_body args; }         \
+    ISA_TARGET_AVX512 inline void name##_avx512 params { name##_body args; }     \
+    inline void name params {                                                    \
+        static void (*const variant) params =                                    \
+            isa_select(name##_sse2, name##_avx2, name##_avx512);                 \
+        variant args;                                                            \
+    }
+#else
+#define ISA_VARIANTS(name, params, args) \
+    inline void name params { name##_body args; }
+#endif
@@ -0,0 +1,171 @@
+// Políticas de lock intercambiables para medirlas bajo contención.
+//
+// Todas tienen la misma interfaz: un tipo Node que el hilo pone en su pila
+// durante la sección crítica (solo MCS lo usa) y lock(node) / unlock(node).
+//   - PthreadMutexLock: pthread_mutex_t, la referencia
+//   - TtasLock: test-and-test-and-set; gira leyendo (sin invalidar la línea
+//     de los demás) y tras cada intento perdido espera el doble
+//   - TicketLock: turnos FIFO con dos contadores; cada uno espera su número
+//   - McsLock: cola de nodos; cada hilo gira sobre su propio nodo, así que
+//     liberar invalida una sola línea ajena
+//   - FutexLock: el mutex de 3 estados de Drepper ("Futexes Are Tricky"):
+//     sin contención no entra al kernel, con contención duerme en el futex
+//
+// Los locks que giran ceden la CPU tras LOCK_SPIN_LIMIT vueltas: con más
+// hilos que núcleos el dueño del lock puede estar esperando CPU.
+#pragma once
+
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "thread_pool.hpp"  // cpu_relax
+
+constexpr int LOCK_SPIN_LIMIT = 1024;
+constexpr int TTAS_MAX_BACKOFF = 1024;  // pausas
+
+// Espera activa que pasa a sched_yield cuando se alarga
+class SpinWait {
+    int count_ = 0;
+
+public:
+    void wait() {
+        if (count_ < LOCK_SPIN_LIMIT) {
+            ++count_;
+            cpu_relax();
+        } else {
+            sched_yield();
+        }
+    }
+};
+
+struct NoNode {};
+
+class PthreadMutexLock {
+    pthread_mutex_t mutex_;
+
+public:
+    using Node = NoNode;
+    static constexpr const char* name = "pthread";
+
+    PthreadMutexLock() { pthread_mutex_init(&mutex_, nullptr); }
+    ~PthreadMutexLock() { pthread_mutex_destroy(&mutex_); }
+    PthreadMutexLock(const PthreadMutexLock&) = delete;
+    PthreadMutexLock& operator=(const PthreadMutexLock&) = delete;
+
+    void lock(Node&) { pthread_mutex_lock(&mutex_); }
+    void unlock(Node&) { pthread_mutex_unlock(&mutex_); }
+};
+
+class TtasLock {
+    alignas(64) std::atomic<bool> locked_{false};
+
+public:
+    using Node = NoNode;
+    static constexpr const char* name = "ttas";
+
+    void lock(Node&) {
+        int backoff = 1;
+        SpinWait spin;
+        for (;;) {
+            while (locked_.load(std::memory_order_relaxed)) spin.wait();
+            if (!locked_.exchange(true, std::memory_order_acquire)) return;
+            // Otro lo tomó primero: esperar antes de volver a leer reparte
+            // los reintentos en vez de que todos choquen a la vez
+            for (int i = 0; i < backoff; ++i) cpu_relax();
+            backoff = std::min(2 * backoff, TTAS_MAX_BACKOFF);
+        }
+    }
+
+    void unlock(Node&) { locked_.store(false, std::memory_order_release); }
+};
+
+class TicketLock {
+    alignas(64) std::atomic<uint32_t> next_{0};
+    alignas(64) std::atomic<uint32_t> serving_{0};
+
+public:
+    using Node = NoNode;
+    static constexpr const char* name = "ticket";
+
+    void lock(Node&) {
+        const uint32_t ticket = next_.fetch_add(1, std::memory_order_relaxed);
+        SpinWait spin;
+        while (serving_.load(std::memory_order_acquire) != ticket) spin.wait();
+    }
+
+    void unlock(Node&) {
+        serving_.store(serving_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
+
+class McsLock {
+public:
+    struct alignas(64) Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<bool> locked{false};
+    };
+    static constexpr const char* name = "mcs";
+
+    void lock(Node& node) {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.locked.store(true, std::memory_order_relaxed);
+        Node* prev = tail_.exchange(&node, std::memory_order_acq_rel);
+        if (!prev) return;
+        prev->next.store(&node, std::memory_order_release);
+        SpinWait spin;
+        while (node.locked.load(std::memory_order_acquire)) spin.wait();
+    }
+
+    void unlock(Node& node) {
+        Node* succ = node.next.load(std::memory_order_acquire);
+        if (!succ) {
+            // Sin sucesor a la vista: si el nodo sigue siendo la cola, el
+            // lock queda libre; si no, alguien está enganchándose
+            Node* expected = &node;
+            if (tail_.compare_exchange_strong(expected, nullptr, std::memory_order_release,
+                                              std::memory_order_relaxed))
+                return;
+            SpinWait spin;
+            while (!(succ = node.next.load(std::memory_order_acquire))) spin.wait();
+        }
+        succ->locked.store(false, std::memory_order_release);
+    }
+
+private:
+    alignas(64) std::atomic<Node*> tail_{nullptr};
+};
+
+class FutexLock {
+    // 0 libre, 1 tomado, 2 tomado y puede haber hilos durmiendo
+    alignas(64) std::atomic<int> state_{0};
+
+    static void futex(std::atomic<int>* addr, int op, int value) {
+        syscall(SYS_futex, reinterpret_cast<int*>(addr), op, value, nullptr, nullptr, 0);
+    }
+
+public:
+    using Node = NoNode;
+    static constexpr const char* name = "futex";
+
+    void lock(Node&) {
+        int c = 0;
+        if (state_.compare_exchange_strong(c, 1, std::memory_order_acquire, std::memory_order_relaxed)) return;
+        if (c != 2) c = state_.exchange(2, std::memory_order_acquire);
+        while (c != 0) {
+            futex(&state_, FUTEX_WAIT_PRIVATE, 2);
+            c = state_.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    void unlock(Node&) {
+        if (state_.fetch_sub(1, std::memory_order_release) != 1) {
+            state_.store(0, std::memory_order_release);
+            futex(&state_, FUTEX_WAKE_PRIVATE, 1);
+        }
+    }
+};
@@ -0,0 +1,228 @@
+// Reducción paralela genérica: reparto del rango y combinación elegibles
+// por separado.
+//
+//   parallel_reduce<Combiner>(begin, end, tasks, identity, map, op, partitioning, runner)
+//
+// Cada tarea recorre sus trozos de [begin, end), acumula local = op(local,
+// map(lo, hi)) partiendo de identity y entrega su parcial al combinador una
+// sola vez. Qué trozos le tocan lo decide Partitioning:
+//   - Block: un bloque contiguo por tarea (pool_chunk)
+//   - Cyclic: el elemento i para la tarea i % tasks (map sobre un elemento)
+//   - BlockCyclic: trozos de `chunk` elementos repartidos en ronda
+//   - Guided: las tareas toman trozos de un contador compartido; cada uno
+//     es una fracción de lo que falta (nunca menos de `chunk`), grandes al
+//     principio y chicos al final, como schedule(guided) de OpenMP
+// Cómo se juntan los parciales lo decide el combinador:
+//   - OrderedCombine: un parcial por tarea en su línea, el llamador los
+//     combina en orden de tarea (el resultado no depende de quién terminó
+//     primero)
+//   - LockCombine<Lock>: total compartido bajo una política de locks.hpp
+//   - AtomicCombine: compare_exchange sobre el total (atomic_ref)
+//   - TreeCombine: log2(tasks) rondas, cada tarea espera a su socio
+// Un combinador es cualquier tipo con una plantilla State<T, Op> que tenga
+// State(tasks, identity, op), combine(id, parcial) y result(); combine lo
+// llaman todas las tareas, también las que no recibieron elementos.
+//
+// runner es quien corre las tareas: cualquier tipo con run(tasks, f(id))
+// que las corra todas a la vez (el árbol necesita que se esperen entre sí).
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "thread_pool.hpp"
+#include "locks.hpp"
+
+// Trozos por tarea cuando chunk = 0 (automático) en BlockCyclic y Guided
+constexpr long long REDUCE_CHUNKS_PER_TASK = 32;
+
+enum class Partition { Block, Cyclic, BlockCyclic, Guided };
+
+inline const char* partition_name(Partition p) {
+    switch (p) {
+        case Partition::Cyclic: return "ciclico";
+        case Partition::BlockCyclic: return "bloque-ciclico";
+        case Partition::Guided: return "guiado";
+        default: return "bloque";
+    }
+}
+
+struct Partitioning {
+    Partition kind = Partition::Block;
+    long long chunk = 0;  // BlockCyclic: tamaño del trozo; Guided: mínimo
+};
+
+// ============================================
+// COMBINADORES
+// ============================================
+struct OrderedCombine {
+    static constexpr const char* name = "ordenado";
+
+    template <typename T, typename Op>
+    class State {
+        struct alignas(64) Partial {
+            T value;
+        };
+        std::vector<Partial> partials_;
+        T identity_;
+        const Op& op_;
+
+    public:
+        State(int tasks, const T& identity, const Op& op)
+            : partials_(tasks, Partial{identity}), identity_(identity), op_(op) {}
+
+        void combine(int id, const T& partial) { partials_[id].value = partial; }
+
+        T result() const {
+            T total = identity_;
+            for (const Partial& p : partials_) total = op_(total, p.value);
+            return total;
+        }
+    };
+};
+
+template <typename Lock = PthreadMutexLock>
+struct LockCombine {
+    static constexpr const char* name = Lock::name;
+
+    template <typename T, typename Op>
+    class State {
+        Lock lock_;
+        T total_;
+        const Op& op_;
+
+    public:
+        State(int, const T& identity, const Op& op) : total_(identity), op_(op) {}
+
+        void combine(int, const T& partial) {
+            typename Lock::Node node;
+            lock_.lock(node);
+            total_ = op_(total_, partial);
+            lock_.unlock(node);
+        }
+
+        T result() const { return total_; }
+    };
+};
+
+// Se lee el total, se calcula el nuevo y compare_exchange lo escribe solo
+// si nadie lo cambió en el medio; si no, se reintenta con el valor nuevo
+struct AtomicCombine {
+    static constexpr const char* name = "atomico";
+
+    template <typename T, typename Op>
+    class State {
+        static_assert(std::is_trivially_copyable_v<T>, "AtomicCombine necesita un T trivialmente copiable");
+        alignas(std::max<size_t>(64, std::atomic_ref<T>::required_alignment)) T total_;
+        const Op& op_;
+
+    public:
+        State(int, const T& identity, const Op& op) : total_(identity), op_(op) {}
+
+        void combine(int, const T& partial) {
+            std::atomic_ref<T> total(total_);
+            T current = total.load(std::memory_order_relaxed);
+            while (!total.compare_exchange_weak(current, op_(current, partial), std::memory_order_relaxed)) {
+            }
+        }
+
+        // El fin de run() ordena las escrituras de las tareas
+        T result() const { return total_; }
+    };
+};
+
+// En la ronda s la tarea id (múltiplo de 2s) espera a la tarea id + s y
+// combina su subárbol; la que no es múltiplo publica lo que lleva y
+// termina. La tarea 0 queda con el total
+struct TreeCombine {
+    static constexpr const char* name = "arbol";
+
+    template <typename T, typename Op>
+    class State {
+        struct alignas(64) Node {
+            T value;
+            std::atomic<bool> ready{false};
+        };
+        std::vector<Node> nodes_;
+        const Op& op_;
+
+    public:
+        State(int tasks, const T& identity, const Op& op) : nodes_(tasks), op_(op) {
+            for (Node& n : nodes_) n.value = identity;
+        }
+
+        void combine(int id, const T& partial) {
+            const int tasks = static_cast<int>(nodes_.size());
+            T value = partial;
+            for (int s = 1; s < tasks; s *= 2) {
+                if (id % (2 * s) != 0) break;
+                const int partner = id + s;
+                if (partner >= tasks) continue;
+                // Con más hilos que núcleos el socio puede no estar
+                // corriendo: se cede la CPU en vez de girar
+                while (!nodes_[partner].ready.load(std::memory_order_acquire)) std::this_thread::yield();
+                value = op_(value, nodes_[partner].value);
+            }
+            nodes_[id].value = value;
+            nodes_[id].ready.store(true, std::memory_order_release);
+        }
+
+        T result() const { return nodes_[0].value; }
+    };
+};
+
+// ============================================
+// MOTOR
+// ============================================
+template <typename Combiner = OrderedCombine, typename Runner = ThreadPool, typename T, typename Map, typename Op>
+T parallel_reduce(long long begin, long long end, int tasks, T identity, const Map& map, const Op& op,
+                  Partitioning partitioning = {}, Runner& runner = default_pool()) {
+    tasks = std::max(1, tasks);
+    const long long n = std::max(0LL, end - begin);
+    long long chunk = partitioning.chunk;
+    if (partitioning.kind == Partition::Cyclic) chunk = 1;
+    if (chunk <= 0) chunk = std::max(1LL, n / (tasks * REDUCE_CHUNKS_PER_TASK));
+
+    typename Combiner::template State<T, Op> state(tasks, identity, op);
+    alignas(64) std::atomic<long long> next(begin);  // Guided
+
+    runner.run(tasks, [&](int id) {
+        T local = identity;
+        switch (partitioning.kind) {
+            case Partition::Block: {
+                long long lo, hi;
+                pool_chunk(begin, end, tasks, id, lo, hi);
+                if (lo < hi) local = op(local, map(lo, hi));
+                break;
+            }
+            case Partition::Cyclic:
+            case Partition::BlockCyclic:
+                for (long long lo = begin + id * chunk; lo < end; lo += tasks * chunk)
+                    local = op(local, map(lo, std::min(lo + chunk, end)));
+                break;
+            case Partition::Guided: {
+                // Si el CAS falla, lo trae el valor nuevo del contador
+                long long lo = next.load(std::memory_order_relaxed);
+                while (lo < end) {
+                    const long long size = std::min(end - lo, std::max(chunk, (end - lo) / (2 * tasks)));
+                    if (next.compare_exchange_weak(lo, lo + size, std::memory_order_relaxed)) {
+                        local = op(local, map(lo, lo + size));
+                        lo = next.load(std::memory_order_relaxed);
+                    }
+                }
+                break;
+            }
+        }
+        state.combine(id, local);
+    });
+    return state.result();
+}
+
+// ThreadPool::parallel_reduce: bloques contiguos y OrderedCombine en este pool
+template <typename T, typename Map, typename Combine>
+T ThreadPool::parallel_reduce(long long begin, long long end, int tasks, T identity, const Map& map,
+                              const Combine& combine) {
+    return ::parallel_reduce<OrderedCombine>(begin, end, tasks, identity, map, combine, Partitioning{}, *this);
+}
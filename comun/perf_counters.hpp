@@ -0,0 +1,187 @@
+// Contadores de hardware con perf_event_open, medidos alrededor de un kernel.
+//
+// Los eventos se abren en grupos pequeños que la PMU programa juntos, de
+// modo que cada cociente (IPC, tasas de fallo) sale de contadores que
+// estuvieron activos en el mismo intervalo:
+//   { ciclos, instrucciones }  { accesos L1D, fallos L1D }
+//   { accesos LLC, fallos LLC }  { saltos, saltos mal predichos }
+//   { fallos dTLB }  { task-clock, fallos de página } (software)
+// Si hay más grupos que contadores físicos el kernel los multiplexa y los
+// valores se escalan con time_enabled / time_running.
+//
+// Se cuenta solo en modo usuario (compatible con perf_event_paranoid = 2) y
+// con inherit, así que también se suman los hilos que el kernel cree y
+// termine (pthread_join) durante la medición.
+//
+// Si perf_event_open no está disponible (paranoid = 3, contenedor sin
+// permisos, máquina virtual sin PMU) los eventos que no abren quedan
+// marcados como no válidos y available() indica si hay alguno.
+#pragma once
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+enum PerfEvent {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_ACCESSES,
+    PERF_L1D_MISSES,
+    PERF_LLC_ACCESSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCHES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_TASK_CLOCK,   // ns
+    PERF_PAGE_FAULTS,
+    PERF_NUM_EVENTS
+};
+
+inline const char* perf_event_name(int e) {
+    static const char* names[PERF_NUM_EVENTS] = {
+        "ciclos", "instrucciones", "accesos_l1d", "fallos_l1d", "accesos_llc", "fallos_llc",
+        "saltos", "saltos_mal_predichos", "fallos_dtlb", "task_clock_ns", "fallos_pagina"};
+    return names[e];
+}
+
+// Valores de una medición; valid[e] es false si el evento no se pudo abrir
+// o nunca llegó a programarse en la PMU
+struct PerfSample {
+    double value[PERF_NUM_EVENTS] = {};
+    bool valid[PERF_NUM_EVENTS] = {};
+
+    bool has(int e) const { return valid[e]; }
+
+    // Cociente a / b, o -1 si falta alguno de los dos
+    double ratio(int a, int b) const {
+        return valid[a] && valid[b] && value[b] > 0 ? value[a] / value[b] : -1.0;
+    }
+    double ipc() const { return ratio(PERF_INSTRUCTIONS, PERF_CYCLES); }
+    double l1d_miss_rate() const { return ratio(PERF_L1D_MISSES, PERF_L1D_ACCESSES); }
+    double llc_miss_rate() const { return ratio(PERF_LLC_MISSES, PERF_LLC_ACCESSES); }
+    double branch_miss_rate() const { return ratio(PERF_BRANCH_MISSES, PERF_BRANCHES); }
+    // Fallos de dTLB por cada 1000 instrucciones
+    double dtlb_mpki() const {
+        double r = ratio(PERF_DTLB_MISSES, PERF_INSTRUCTIONS);
+        return r < 0 ? r : r * 1000.0;
+    }
+};
+
+inline uint64_t perf_cache_config(uint64_t cache, uint64_t op, uint64_t result) {
+    return cache | (op << 8) | (result << 16);
+}
+
+class PerfCounters {
+    struct Event {
+        int id;
+        uint32_t type;
+        uint64_t config;
+    };
+
+    int fd_[PERF_NUM_EVENTS];
+    std::vector<int> leaders_;
+    std::string error_;
+
+    static int open_event(uint32_t type, uint64_t config, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = group_fd == -1 ? 1 : 0;  // el líder arranca el grupo
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    // Abre un grupo; si el líder falla el grupo entero queda sin abrir
+    void open_group(const std::vector<Event>& events) {
+        int leader = -1;
+        for (const Event& ev : events) {
+            int fd = open_event(ev.type, ev.config, leader);
+            if (fd < 0) {
+                if (error_.empty())
+                    error_ = std::string(perf_event_name(ev.id)) + ": " + std::strerror(errno);
+                if (leader == -1) return;
+                continue;
+            }
+            fd_[ev.id] = fd;
+            if (leader == -1) {
+                leader = fd;
+                leaders_.push_back(fd);
+            }
+        }
+    }
+
+public:
+    PerfCounters() {
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e) fd_[e] = -1;
+
+        const uint64_t read = PERF_COUNT_HW_CACHE_OP_READ;
+        const uint64_t access = PERF_COUNT_HW_CACHE_RESULT_ACCESS;
+        const uint64_t miss = PERF_COUNT_HW_CACHE_RESULT_MISS;
+        open_group({{PERF_CYCLES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+                    {PERF_INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS}});
+        open_group({{PERF_L1D_ACCESSES, PERF_TYPE_HW_CACHE, perf_cache_config(PERF_COUNT_HW_CACHE_L1D, read, access)},
+                    {PERF_L1D_MISSES, PERF_TYPE_HW_CACHE, perf_cache_config(PERF_COUNT_HW_CACHE_L1D, read, miss)}});
+        open_group({{PERF_LLC_ACCESSES, PERF_TYPE_HW_CACHE, perf_cache_config(PERF_COUNT_HW_CACHE_LL, read, access)},
+                    {PERF_LLC_MISSES, PERF_TYPE_HW_CACHE, perf_cache_config(PERF_COUNT_HW_CACHE_LL, read, miss)}});
+        open_group({{PERF_BRANCHES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS},
+                    {PERF_BRANCH_MISSES, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}});
+        open_group({{PERF_DTLB_MISSES, PERF_TYPE_HW_CACHE, perf_cache_config(PERF_COUNT_HW_CACHE_DTLB, read, miss)}});
+        open_group({{PERF_TASK_CLOCK, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+                    {PERF_PAGE_FAULTS, PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS}});
+    }
+
+    ~PerfCounters() {
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e)
+            if (fd_[e] >= 0) close(fd_[e]);
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // true si se pudo abrir al menos un contador de hardware
+    bool available() const { return fd_[PERF_CYCLES] >= 0 || fd_[PERF_L1D_MISSES] >= 0; }
+
+    // Primer error de perf_event_open (vacío si todo abrió)
+    const std::string& error() const { return error_; }
+
+    void start() {
+        for (int fd : leaders_) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    PerfSample stop() {
+        for (int fd : leaders_) ioctl(fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        PerfSample s;
+        for (int e = 0; e < PERF_NUM_EVENTS; ++e) {
+            if (fd_[e] < 0) continue;
+            uint64_t buf[3];  // valor, time_enabled, time_running
+            if (::read(fd_[e], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) continue;
+            if (buf[2] == 0) continue;  // nunca se programó en la PMU
+            s.value[e] = static_cast<double>(buf[0]) * buf[1] / buf[2];
+            s.valid[e] = true;
+        }
+        return s;
+    }
+};
+
+// Contadores de una ejecución de `kernel`
+template <typename Kernel>
+PerfSample measure_counters(PerfCounters& counters, Kernel&& kernel) {
+    counters.start();
+    kernel();
+    return counters.stop();
+}
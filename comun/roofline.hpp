@@ -0,0 +1,276 @@
+// Modelo roofline: techos medidos de la máquina y posición de cada kernel.
+//
+// Rendimiento alcanzable(I) = min(pico FMA, I * ancho de banda), con I la
+// intensidad aritmética (FLOP / byte movido desde memoria). Los dos techos
+// se miden al arrancar:
+//   - pico FMA: acumuladores SIMD independientes, al ancho de la variante ISA
+//     activa (cpu_dispatch.hpp), la misma que usan los kernels
+//   - ancho de banda: triad de STREAM a[i] = b[i] + s * c[i] (24 bytes por
+//     elemento, sin contar el write-allocate, como STREAM)
+// Ambos con el número de hilos que vaya a usar el kernel.
+#pragma once
+
+#include <pthread.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "benchmark.hpp"
+#include "cpu_dispatch.hpp"
+
+struct Ceilings {
+    int threads = 1;
+    double peak_gflops = 0.0;
+    double bandwidth_gbs = 0.0;
+
+    // Intensidad donde se cruzan los dos techos (FLOP/byte)
+    double ridge() const { return peak_gflops / bandwidth_gbs; }
+    double attainable(double intensity) const {
+        return std::min(peak_gflops, intensity * bandwidth_gbs);
+    }
+    // Qué limita a un kernel: el techo que le toca según su intensidad, o
+    // "cache" si lo supera (los datos no vienen de memoria principal entre
+    // repeticiones y el modelo de tráfico sobreestima los bytes)
+    const char* bound(double intensity, double gflops) const {
+        if (gflops > attainable(intensity)) return "cache";
+        return intensity < ridge() ? "memoria" : "computo";
+    }
+};
+
+// Un kernel medido: FLOPs y bytes vienen del modelo de tráfico del kernel
+struct RooflinePoint {
+    std::string name;
+    double flops = 0.0;
+    double bytes = 0.0;
+    double seconds = 0.0;
+
+    double intensity() const { return flops / bytes; }
+    double gflops() const { return flops / seconds * 1e-9; }
+};
+
+// ============================================
+// SONDAS
+// ============================================
+// Acumuladores independientes: hacen falta latencia de la FMA x puertos FMA
+// (4 x 2 = 8 en Skylake, 5 x 2 = 10 en Zen 2); 12 cubre hasta 6 ciclos
+constexpr int ROOF_ACCUMULATORS = 12;
+constexpr long ROOF_FMA_ITERS = 20000000;
+
+struct ProbeArgs {
+    double* a;
+    const double* b;
+    const double* c;
+    size_t first, last;
+    double result;
+};
+
+// Registros SIMD de cada variante con los vectores de GCC: el compilador
+// emite FMA (si la variante la tiene) y deja los acumuladores en registros
+// también con -O2, que es como se compilan los programas de py/
+typedef double roof_vec128 __attribute__((vector_size(16)));
+typedef double roof_vec256 __attribute__((vector_size(32)));
+typedef double roof_vec512 __attribute__((vector_size(64)));
+
+template <typename vec>
+ISA_INLINE double fma_probe_body() {
+    vec acc[ROOF_ACCUMULATORS];
+    for (int l = 0; l < ROOF_ACCUMULATORS; ++l) acc[l] = vec{} + l * 1e-3;
+    const vec m = vec{} + 0.999999, add = vec{} + 1e-7;
+    for (long it = 0; it < ROOF_FMA_ITERS; ++it) {
+#pragma GCC unroll 16
+        for (int l = 0; l < ROOF_ACCUMULATORS; ++l)
+            acc[l] = acc[l] * m + add;
+    }
+    double sum = 0.0;
+    for (int l = 0; l < ROOF_ACCUMULATORS; ++l)
+        for (int k = 0; k < int(sizeof(vec) / sizeof(double)); ++k) sum += acc[l][k];
+    return sum;
+}
+
+inline double fma_probe_sse2() { return fma_probe_body<roof_vec128>(); }
+#if defined(ISA_X86)
+ISA_TARGET_AVX2 inline double fma_probe_avx2() { return fma_probe_body<roof_vec256>(); }
+ISA_TARGET_AVX512 inline double fma_probe_avx512() { return fma_probe_body<roof_vec512>(); }
+#endif
+
+// doubles por registro de la variante activa
+inline int roof_lanes() {
+    return active_isa() == Isa::AVX512 ? 8 : active_isa() == Isa::AVX2 ? 4 : 2;
+}
+
+inline void* fma_probe_thread(void* arg) {
+    ProbeArgs* args = static_cast<ProbeArgs*>(arg);
+#if defined(ISA_X86)
+    args->result = isa_select(fma_probe_sse2, fma_probe_avx2, fma_probe_avx512)();
+#else
+    args->result = fma_probe_sse2();
+#endif
+    return nullptr;
+}
+
+inline void* triad_probe_thread(void* arg) {
+    ProbeArgs* args = static_cast<ProbeArgs*>(arg);
+    const double s = 3.0;
+    for (size_t i = args->first; i < args->last; ++i)
+        args->a[i] = args->b[i] + s * args->c[i];
+    return nullptr;
+}
+
+// Primera escritura desde el hilo que luego recorre el trozo (páginas locales)
+inline void* triad_init_thread(void* arg) {
+    ProbeArgs* args = static_cast<ProbeArgs*>(arg);
+    for (size_t i = args->first; i < args->last; ++i) {
+        args->a[i] = 0.0;
+        const_cast<double*>(args->b)[i] = 1.0;
+        const_cast<double*>(args->c)[i] = 2.0;
+    }
+    return nullptr;
+}
+
+inline void run_probe_threads(void* (*fn)(void*), std::vector<ProbeArgs>& args) {
+    std::vector<pthread_t> hilos(args.size());
+    for (size_t t = 0; t < args.size(); ++t) pthread_create(&hilos[t], nullptr, fn, &args[t]);
+    for (size_t t = 0; t < args.size(); ++t) pthread_join(hilos[t], nullptr);
+}
+
+inline double probe_peak_gflops(int threads) {
+    std::vector<ProbeArgs> args(threads);
+    BenchStats st = run_benchmark("techo/fma/hilos=" + std::to_string(threads), [&]() {
+        run_probe_threads(fma_probe_thread, args);
+    });
+    for (const ProbeArgs& a : args) do_not_optimize(a.result);
+    return 2.0 * ROOF_ACCUMULATORS * roof_lanes() * ROOF_FMA_ITERS * threads / st.median * 1e-9;
+}
+
+// array_bytes: tamaño de cada uno de los tres arreglos (debe superar la LLC)
+inline double probe_bandwidth_gbs(int threads, size_t array_bytes) {
+    const size_t n = array_bytes / sizeof(double);
+    std::vector<double> a(n), b(n), c(n);
+    std::vector<ProbeArgs> args(threads);
+    for (int t = 0; t < threads; ++t) {
+        args[t] = {a.data(), b.data(), c.data(), n * t / threads, n * (t + 1) / threads, 0.0};
+    }
+    run_probe_threads(triad_init_thread, args);
+
+    BenchStats st = run_benchmark("techo/stream_triad/hilos=" + std::to_string(threads), [&]() {
+        run_probe_threads(triad_probe_thread, args);
+    });
+    return 3.0 * sizeof(double) * n / st.median * 1e-9;
+}
+
+inline Ceilings probe_ceilings(int threads, size_t array_bytes = size_t(256) << 20) {
+    Ceilings c;
+    c.threads = threads;
+    c.peak_gflops = probe_peak_gflops(threads);
+    c.bandwidth_gbs = probe_bandwidth_gbs(threads, array_bytes);
+    return c;
+}
+
+// ============================================
+// SALIDA
+// ============================================
+inline void write_roofline_csv(const std::vector<RooflinePoint>& points, const Ceilings& c,
+                               const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << filename << " para escribir resultados\n";
+        return;
+    }
+    file << "Kernel,FLOPs,Bytes,Tiempo_s,Intensidad,GFLOPs,Techo_GFLOPs,Fraccion_Techo,Limite,"
+         << "Pico_GFLOPs,Ancho_Banda_GBs,Hilos\n";
+    for (const RooflinePoint& p : points) {
+        double roof = c.attainable(p.intensity());
+        file << p.name << "," << std::setprecision(6) << p.flops << "," << p.bytes << ","
+             << p.seconds << "," << p.intensity() << "," << p.gflops() << "," << roof << ","
+             << p.gflops() / roof << "," << c.bound(p.intensity(), p.gflops()) << ","
+             << c.peak_gflops << "," << c.bandwidth_gbs << "," << c.threads << "\n";
+    }
+    std::cout << "Resultados guardados en: " << filename << "\n";
+}
+
+inline void print_ceilings(const Ceilings& c) {
+    std::cout << "Techos medidos (" << c.threads << " hilo" << (c.threads > 1 ? "s" : "") << ", "
+              << isa_name(active_isa()) << "): "
+              << std::fixed << std::setprecision(1) << c.peak_gflops << " GFLOP/s FMA, "
+              << c.bandwidth_gbs << " GB/s (STREAM triad), cruce en "
+              << std::setprecision(2) << c.ridge() << " FLOP/byte\n";
+}
+
+// Fracción del techo alcanzable, en el estilo de generar_grafico_ascii_*
+inline void print_roofline_bars(const std::vector<RooflinePoint>& points, const Ceilings& c) {
+    std::cout << "\nGRAFICO DE FRACCION DEL TECHO ALCANZABLE\n";
+    std::cout << "==========================================\n";
+
+    const int MAX_BARRAS = 40;
+
+    for (const RooflinePoint& p : points) {
+        double roof = c.attainable(p.intensity());
+        double fraction = p.gflops() / roof;
+        int longitud_barra = static_cast<int>(std::min(1.0, fraction) * MAX_BARRAS);
+        std::cout << std::left << std::setw(25) << p.name
+                  << "[" << std::string(longitud_barra, '#')
+                  << std::string(MAX_BARRAS - longitud_barra, ' ') << "] "
+                  << std::right << std::fixed << std::setprecision(1) << std::setw(5) << fraction * 100
+                  << "% de " << std::setprecision(2) << roof << " GFLOP/s ("
+                  << c.bound(p.intensity(), p.gflops()) << ")\n";
+    }
+}
+
+// Gráfico log-log: eje x intensidad (potencias de 2), eje y GFLOP/s
+// (potencias de 10). El techo se dibuja con '/' (memoria) y '-' (cómputo);
+// cada kernel es una letra ('*' si dos caen en la misma celda).
+inline void print_roofline_chart(const std::vector<RooflinePoint>& points, const Ceilings& c) {
+    const int WIDTH = 64, HEIGHT = 20;
+
+    double x_min = c.ridge(), x_max = c.ridge();
+    double y_min = c.peak_gflops, y_max = c.peak_gflops * 1.5;
+    for (const RooflinePoint& p : points) {
+        x_min = std::min(x_min, p.intensity());
+        x_max = std::max(x_max, p.intensity());
+        y_min = std::min(y_min, p.gflops());
+        y_max = std::max(y_max, p.gflops() * 1.5);
+    }
+    double lx0 = std::floor(std::log2(x_min)) - 1, lx1 = std::ceil(std::log2(x_max)) + 1;
+    double ly0 = std::floor(std::log10(y_min)), ly1 = std::log10(y_max);
+
+    auto column = [&](double x) {
+        return static_cast<int>(std::lround((std::log2(x) - lx0) / (lx1 - lx0) * (WIDTH - 1)));
+    };
+    auto row = [&](double y) {
+        return HEIGHT - 1 - static_cast<int>(std::lround((std::log10(y) - ly0) / (ly1 - ly0) * (HEIGHT - 1)));
+    };
+
+    std::vector<std::string> grid(HEIGHT, std::string(WIDTH, ' '));
+    for (int col = 0; col < WIDTH; ++col) {
+        double x = std::exp2(lx0 + (lx1 - lx0) * col / (WIDTH - 1));
+        int r = row(c.attainable(x));
+        if (r >= 0 && r < HEIGHT) grid[r][col] = x < c.ridge() ? '/' : '-';
+    }
+    for (size_t k = 0; k < points.size(); ++k) {
+        int r = row(points[k].gflops()), col = column(points[k].intensity());
+        if (r < 0 || r >= HEIGHT || col < 0 || col >= WIDTH) continue;
+        char& cell = grid[r][col];
+        cell = (cell >= 'A' && cell <= 'Z') ? '*' : static_cast<char>('A' + k);
+    }
+
+    std::cout << "\nROOFLINE (log-log)\n";
+    std::cout << "==========================================\n";
+    for (int r = 0; r < HEIGHT; ++r) {
+        double y = std::pow(10.0, ly0 + (ly1 - ly0) * (HEIGHT - 1 - r) / (HEIGHT - 1));
+        std::cout << std::right << std::fixed << std::setprecision(y < 1 ? 2 : y < 10 ? 1 : 0)
+                  << std::setw(8) << y << " |" << grid[r] << "\n";
+    }
+    std::cout << std::string(9, ' ') << "+" << std::string(WIDTH, '-') << "\n";
+    std::cout << std::string(10, ' ') << std::left << std::setw(WIDTH / 2)
+              << ("2^" + std::to_string(static_cast<int>(lx0)))
+              << std::right << std::setw(WIDTH / 2)
+              << ("2^" + std::to_string(static_cast<int>(lx1))) << "  FLOP/byte\n";
+    for (size_t k = 0; k < points.size(); ++k) {
+        std::cout << "  " << static_cast<char>('A' + k) << ": " << std::left << std::setw(25)
+                  << points[k].name << std::right << std::setprecision(3)
+                  << " I=" << points[k].intensity() << "  " << points[k].gflops() << " GFLOP/s\n";
+    }
+}
@@ -0,0 +1,157 @@
+// Escalado fuerte y débil: speedup por número de hilos y ajuste de las
+// leyes de Amdahl y Gustafson.
+//
+// Cada serie es un kernel medido con 1..p hilos. Cada punto guarda el
+// trabajo hecho (términos, FLOPs) para tratar los dos modos igual:
+//   speedup(p) = (W(p) / W(1)) * T(1) / T(p)
+// En escalado fuerte W es constante y queda T(1) / T(p); en débil W crece
+// con p y queda el speedup escalado de Gustafson.
+//
+// Ajustes por mínimos cuadrados (la fracción serial f es el único parámetro):
+//   Amdahl (fuerte):    1/S = f + (1 - f)/p   ->  1/S - 1/p = f (1 - 1/p)
+//   Gustafson (débil):  S = p - f (p - 1)     ->  p - S     = f (p - 1)
+// Las dos son rectas por el origen en f. Con un solo punto (p = 1) no hay
+// nada que ajustar y la fracción queda en -1.
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+enum class ScalingMode { Strong, Weak };
+
+inline const char* scaling_mode_name(ScalingMode m) {
+    return m == ScalingMode::Strong ? "fuerte" : "debil";
+}
+
+struct ScalingPoint {
+    int threads;
+    double work;     // unidades de trabajo (términos, FLOPs, ...)
+    double seconds;
+};
+
+struct ScalingSeries {
+    std::string name;
+    ScalingMode mode;
+    std::vector<ScalingPoint> points;  // points[0] es la referencia (1 hilo)
+
+    double speedup(size_t i) const {
+        const ScalingPoint& ref = points[0];
+        return (points[i].work / ref.work) * (ref.seconds / points[i].seconds);
+    }
+    double efficiency(size_t i) const { return speedup(i) / points[i].threads; }
+};
+
+// Métrica de Karp-Flatt: fracción serial que explica el speedup medido en
+// un solo punto. Si crece con p el costo extra es sobrecarga (sincronización,
+// memoria), no código serial.
+inline double karp_flatt(double speedup, int threads) {
+    if (threads <= 1) return -1.0;
+    return (1.0 / speedup - 1.0 / threads) / (1.0 - 1.0 / threads);
+}
+
+inline double amdahl_speedup(double serial, int threads) {
+    return 1.0 / (serial + (1.0 - serial) / threads);
+}
+
+inline double gustafson_speedup(double serial, int threads) {
+    return threads - serial * (threads - 1);
+}
+
+// Fracción serial ajustada con la ley que corresponde al modo de la serie
+inline double fit_serial_fraction(const ScalingSeries& s) {
+    double sxy = 0.0, sxx = 0.0;
+    for (size_t i = 0; i < s.points.size(); ++i) {
+        double p = s.points[i].threads, S = s.speedup(i), x, y;
+        if (s.mode == ScalingMode::Strong) {
+            x = 1.0 - 1.0 / p;
+            y = 1.0 / S - 1.0 / p;
+        } else {
+            x = p - 1.0;
+            y = p - S;
+        }
+        sxy += x * y;
+        sxx += x * x;
+    }
+    if (sxx == 0.0) return -1.0;
+    return std::min(1.0, std::max(0.0, sxy / sxx));
+}
+
+// Speedup que predice el ajuste con p hilos
+inline double model_speedup(const ScalingSeries& s, double serial, int threads) {
+    if (serial < 0.0) return -1.0;
+    return s.mode == ScalingMode::Strong ? amdahl_speedup(serial, threads)
+                                         : gustafson_speedup(serial, threads);
+}
+
+// 1, 2, ..., max_threads
+inline std::vector<int> scaling_thread_counts(int max_threads) {
+    std::vector<int> counts;
+    for (int t = 1; t <= std::max(1, max_threads); ++t) counts.push_back(t);
+    return counts;
+}
+
+// ============================================
+// REPORTE
+// ============================================
+inline void print_scaling_table(const std::vector<ScalingSeries>& series) {
+    std::cout << std::left << std::setw(25) << "Serie" << std::setw(8) << "Modo" << std::right
+              << std::setw(7) << "Hilos" << std::setw(12) << "Tiempo(s)" << std::setw(10) << "Speedup"
+              << std::setw(12) << "Eficiencia" << std::setw(12) << "Karp-Flatt" << std::setw(10) << "Modelo"
+              << "\n";
+    std::cout << std::string(96, '-') << "\n";
+    for (const ScalingSeries& s : series) {
+        double f = fit_serial_fraction(s);
+        for (size_t i = 0; i < s.points.size(); ++i) {
+            int p = s.points[i].threads;
+            double kf = karp_flatt(s.speedup(i), p);
+            std::cout << std::left << std::setw(25) << (i == 0 ? s.name : "") << std::setw(8)
+                      << (i == 0 ? scaling_mode_name(s.mode) : "") << std::right << std::fixed
+                      << std::setw(7) << p << std::setw(12) << std::setprecision(4) << s.points[i].seconds
+                      << std::setw(10) << std::setprecision(2) << s.speedup(i)
+                      << std::setw(11) << std::setprecision(1) << s.efficiency(i) * 100 << "%";
+            if (kf < 0.0) std::cout << std::setw(12) << "-";
+            else std::cout << std::setw(12) << std::setprecision(3) << kf;
+            if (f < 0.0) std::cout << std::setw(10) << "-";
+            else std::cout << std::setw(10) << std::setprecision(2) << model_speedup(s, f, p);
+            std::cout << "\n";
+        }
+        if (f < 0.0) {
+            std::cout << "  sin ajuste: hace falta medir con más de un hilo\n";
+        } else if (s.mode == ScalingMode::Strong) {
+            std::cout << "  Amdahl: fracción serial " << std::setprecision(4) << f << ", speedup máximo ";
+            if (f > 0.0) std::cout << std::setprecision(1) << 1.0 / f << "x\n";
+            else std::cout << "ilimitado\n";
+        } else {
+            std::cout << "  Gustafson: fracción serial " << std::setprecision(4) << f << ", S(p) = "
+                      << std::setprecision(2) << 1.0 - f << " p + " << f << "\n";
+        }
+    }
+    std::cout << std::string(96, '-') << "\n";
+}
+
+// Una fila por serie y número de hilos, con la fracción serial ajustada de
+// la serie repetida en cada fila (cómodo para pandas / groupby)
+inline void write_scaling_csv(const std::vector<ScalingSeries>& series, const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: No se pudo abrir " << filename << " para escribir resultados\n";
+        return;
+    }
+    file << "Modo,Estrategia,Hilos,Trabajo,Tiempo_s,Speedup,Eficiencia,Karp_Flatt,"
+         << "Fraccion_Serial,Speedup_Modelo\n";
+    for (const ScalingSeries& s : series) {
+        double f = fit_serial_fraction(s);
+        for (size_t i = 0; i < s.points.size(); ++i) {
+            int p = s.points[i].threads;
+            file << scaling_mode_name(s.mode) << "," << s.name << "," << p << ","
+                 << std::setprecision(6) << s.points[i].work << "," << s.points[i].seconds << ","
+                 << s.speedup(i) << "," << s.efficiency(i) << "," << karp_flatt(s.speedup(i), p) << ","
+                 << f << "," << model_speedup(s, f, p) << "\n";
+        }
+    }
+    std::cout << "Resultados guardados en: " << filename << "\n";
+}
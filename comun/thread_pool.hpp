@@ -0,0 +1,209 @@
+// Pool de hilos persistente con despacho fork-join.
+//
+// Crear y juntar p pthreads cuesta decenas de microsegundos por llamada;
+// con entradas chicas ese costo es todo el tiempo. Aquí los hilos se crean
+// una vez (al primer trabajo que los necesita) y entre trabajos esperan
+// estacionados:
+//   - Cada trabajador tiene su propio turno. run() incrementa el turno de
+//     los trabajadores que usa; los demás siguen dormidos.
+//   - Al terminar una tarea el trabajador gira un rato mirando su turno (el
+//     próximo trabajo suele llegar enseguida) y después se duerme en una
+//     variable de condición. Con un solo núcleo no gira: le quitaría la CPU
+//     al hilo que tiene que publicar el trabajo.
+//   - El llamador hace la tarea 0 y espera a las demás de la misma forma.
+//
+// run(tareas, f) llama a f(id) con id en [0, tareas), cada tarea en su
+// propio hilo a la vez, así que las tareas pueden esperarse entre sí (turnos,
+// reducción en árbol). parallel_for reparte un rango en bloques contiguos
+// sobre run(); parallel_reduce es el de parallel_reduce.hpp con bloques y
+// parciales en orden (está definido allí: hay que incluirlo para usarlo).
+// Un solo llamador a la vez: run() no es reentrante ni se puede llamar
+// desde una tarea.
+//
+// Los trabajadores no heredan la afinidad de PARALELA_BENCH_PIN_CPU si se
+// crearon antes de la medición.
+#pragma once
+
+#include <pthread.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Iteraciones de espera activa antes de dormir (~10-50 us)
+constexpr int POOL_SPIN = 4000;
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Bloque `id` de `parts` bloques contiguos de [begin, end): los primeros
+// (end - begin) % parts llevan un elemento más, no se pierde ninguno
+inline void pool_chunk(long long begin, long long end, int parts, int id, long long& lo, long long& hi) {
+    const long long n = end - begin;
+    const long long base = n / parts, rem = n % parts;
+    lo = begin + id * base + std::min<long long>(id, rem);
+    hi = lo + base + (id < rem ? 1 : 0);
+}
+
+class ThreadPool {
+    struct alignas(64) Worker {
+        ThreadPool* pool;
+        int id;
+        pthread_t thread;
+        std::atomic<uint64_t> turn{0};  // trabajos publicados para este hilo
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;  // workers_[k] hace la tarea k + 1
+    int spin_;
+
+    // Trabajo actual: f(id) a través de un puntero a función sin tipo
+    void (*invoke_)(const void*, int) = nullptr;
+    const void* task_ = nullptr;
+    alignas(64) std::atomic<int> pending_{0};  // tareas de trabajadores sin terminar
+    std::atomic<bool> stop_{false};
+
+    pthread_mutex_t mutex_;
+    pthread_cond_t wake_;   // turnos nuevos (o stop_)
+    pthread_cond_t done_;   // pending_ llegó a 0
+    int sleeping_ = 0;      // trabajadores dormidos en wake_
+    bool waiting_ = false;  // el llamador duerme en done_
+
+    static void* worker_main(void* arg) {
+        Worker* w = static_cast<Worker*>(arg);
+        w->pool->work(*w);
+        return nullptr;
+    }
+
+    void work(Worker& w) {
+        uint64_t seen = 0;
+        for (;;) {
+            uint64_t turn = w.turn.load(std::memory_order_acquire);
+            for (int s = 0; turn == seen && s < spin_; ++s) {
+                cpu_relax();
+                turn = w.turn.load(std::memory_order_acquire);
+            }
+            if (turn == seen) {
+                pthread_mutex_lock(&mutex_);
+                while ((turn = w.turn.load(std::memory_order_acquire)) == seen &&
+                       !stop_.load(std::memory_order_relaxed)) {
+                    ++sleeping_;
+                    pthread_cond_wait(&wake_, &mutex_);
+                    --sleeping_;
+                }
+                pthread_mutex_unlock(&mutex_);
+            }
+            if (turn == seen) return;  // stop_
+            seen = turn;
+
+            invoke_(task_, w.id);
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                pthread_mutex_lock(&mutex_);
+                if (waiting_) pthread_cond_signal(&done_);
+                pthread_mutex_unlock(&mutex_);
+            }
+        }
+    }
+
+    void grow(int count) {
+        while (static_cast<int>(workers_.size()) < count) {
+            auto w = std::make_unique<Worker>();
+            w->pool = this;
+            w->id = static_cast<int>(workers_.size()) + 1;
+            pthread_create(&w->thread, nullptr, worker_main, w.get());
+            workers_.push_back(std::move(w));
+        }
+    }
+
+    void dispatch(int tasks, void (*invoke)(const void*, int), const void* task) {
+        if (tasks <= 1) {
+            if (tasks == 1) invoke(task, 0);
+            return;
+        }
+        grow(tasks - 1);
+        invoke_ = invoke;
+        task_ = task;
+        pending_.store(tasks - 1, std::memory_order_relaxed);
+        // release: quien vea su turno nuevo ve también invoke_ y task_
+        for (int k = 0; k < tasks - 1; ++k) workers_[k]->turn.fetch_add(1, std::memory_order_release);
+        pthread_mutex_lock(&mutex_);
+        if (sleeping_ > 0) pthread_cond_broadcast(&wake_);
+        pthread_mutex_unlock(&mutex_);
+
+        invoke(task, 0);
+
+        for (int s = 0; pending_.load(std::memory_order_acquire) != 0 && s < spin_; ++s) cpu_relax();
+        if (pending_.load(std::memory_order_acquire) != 0) {
+            pthread_mutex_lock(&mutex_);
+            waiting_ = true;
+            while (pending_.load(std::memory_order_acquire) != 0) pthread_cond_wait(&done_, &mutex_);
+            waiting_ = false;
+            pthread_mutex_unlock(&mutex_);
+        }
+    }
+
+public:
+    // spin: iteraciones de espera activa antes de dormir (-1 = POOL_SPIN si
+    // hay más de un núcleo, 0 si no)
+    explicit ThreadPool(int spin = -1)
+        : spin_(spin >= 0 ? spin : (std::thread::hardware_concurrency() > 1 ? POOL_SPIN : 0)) {
+        pthread_mutex_init(&mutex_, nullptr);
+        pthread_cond_init(&wake_, nullptr);
+        pthread_cond_init(&done_, nullptr);
+    }
+
+    ~ThreadPool() {
+        pthread_mutex_lock(&mutex_);
+        stop_.store(true, std::memory_order_relaxed);
+        pthread_cond_broadcast(&wake_);
+        pthread_mutex_unlock(&mutex_);
+        for (auto& w : workers_) pthread_join(w->thread, nullptr);
+        pthread_cond_destroy(&done_);
+        pthread_cond_destroy(&wake_);
+        pthread_mutex_destroy(&mutex_);
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Hilos del pool además del llamador
+    int workers() const { return static_cast<int>(workers_.size()); }
+
+    // f(id) para id en [0, tasks), todas a la vez; vuelve cuando terminan
+    template <typename F>
+    void run(int tasks, const F& f) {
+        dispatch(tasks, [](const void* task, int id) { (*static_cast<const F*>(task))(id); }, &f);
+    }
+
+    // f(lo, hi) sobre `tasks` bloques contiguos de [begin, end)
+    template <typename F>
+    void parallel_for(long long begin, long long end, int tasks, const F& f) {
+        run(tasks, [&](int id) {
+            long long lo, hi;
+            pool_chunk(begin, end, tasks, id, lo, hi);
+            if (lo < hi) f(lo, hi);
+        });
+    }
+
+    // map(lo, hi) -> T por bloque; los parciales se combinan en orden de
+    // bloque, así que el resultado no depende de qué hilo terminó primero
+    template <typename T, typename Map, typename Combine>
+    T parallel_reduce(long long begin, long long end, int tasks, T identity, const Map& map,
+                      const Combine& combine);
+};
+
+// Pool compartido del programa
+inline ThreadPool& default_pool() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,262 @@
+// Planificador con robo de trabajo para bucles paralelos irregulares.
+//
+// El reparto estático (un bloque fijo por hilo) termina cuando termina el
+// hilo más lento: si un núcleo corre más despacio o lo comparte otro
+// proceso, los demás esperan sin hacer nada. Aquí cada participante:
+//   1. empieza con su bloque estático de [begin, end) (misma localidad que
+//      el reparto estático cuando no hay desbalance);
+//   2. parte su rango por la mitad mientras supere `grain`, deja la mitad
+//      superior en su deque y sigue con la inferior;
+//   3. al vaciar su rango saca de su deque por abajo (lo último que dejó,
+//      lo más chico y caliente en caché);
+//   4. con el deque vacío roba por arriba del deque de una víctima al azar
+//      (lo más antiguo, el trozo más grande).
+// Los deques son de Chase-Lev con los órdenes de memoria de Lê, Pop, Cohen
+// y Zappa Nardelli (PPoPP 2013). Con partición binaria un deque nunca tiene
+// más de log2(rango / grain) trozos, así que la capacidad es fija.
+//
+// Los participantes corren en el ThreadPool (uno por tarea, el llamador es
+// el 0) y el bucle termina cuando se ejecutó todo el rango.
+#pragma once
+
+#include <pthread.h>
+#include <sched.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "thread_pool.hpp"
+
+// Trozos por participante cuando grain = 0 (automático)
+constexpr long long WS_CHUNKS_PER_TASK = 32;
+
+// Robos fallidos seguidos antes de ceder la CPU y antes de dormir, y
+// duración de cada siesta
+constexpr int WS_SPIN_STEALS = 64, WS_YIELD_STEALS = 256;
+constexpr int WS_SLEEP_US = 20;
+
+struct StealRange {
+    long long lo, hi;
+};
+
+// ============================================
+// DEQUE DE CHASE-LEV
+// ============================================
+// push y take solo los llama el dueño; steal cualquier otro hilo. Los
+// extremos de cada trozo son atómicos relajados: un ladrón puede leer una
+// ranura que el dueño está reescribiendo, pero entonces su CAS sobre top_
+// falla y descarta lo leído.
+class ChaseLevDeque {
+    static constexpr long long CAPACITY = 128;  // potencia de 2
+
+    struct Slot {
+        std::atomic<long long> lo{0}, hi{0};
+    };
+
+    alignas(64) std::atomic<long long> top_{0};
+    alignas(64) std::atomic<long long> bottom_{0};
+    alignas(64) Slot slots_[CAPACITY];
+
+public:
+    enum class Steal { Ok, Empty, Lost };
+
+    // false si está lleno (el dueño se queda el trozo entero)
+    bool push(StealRange r) {
+        const long long b = bottom_.load(std::memory_order_relaxed);
+        const long long t = top_.load(std::memory_order_acquire);
+        if (b - t >= CAPACITY) return false;
+        Slot& s = slots_[b & (CAPACITY - 1)];
+        s.lo.store(r.lo, std::memory_order_relaxed);
+        s.hi.store(r.hi, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Saca el último trozo que dejó el dueño
+    bool take(StealRange& r) {
+        const long long b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = top_.load(std::memory_order_relaxed);
+        if (t > b) {  // vacío
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        const Slot& s = slots_[b & (CAPACITY - 1)];
+        r = {s.lo.load(std::memory_order_relaxed), s.hi.load(std::memory_order_relaxed)};
+        if (t == b) {  // último trozo: se compite con los ladrones
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Roba el trozo más antiguo; Lost si otro hilo se lo llevó primero
+    Steal steal(StealRange& r) {
+        long long t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const long long b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return Steal::Empty;
+        const Slot& s = slots_[t & (CAPACITY - 1)];
+        r = {s.lo.load(std::memory_order_relaxed), s.hi.load(std::memory_order_relaxed)};
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return Steal::Lost;
+        return Steal::Ok;
+    }
+};
+
+// ============================================
+// PLANIFICADOR
+// ============================================
+struct StealStats {
+    long long chunks = 0;         // trozos ejecutados
+    long long steals = 0;         // robos con éxito
+    long long failed_steals = 0;  // intentos sobre un deque vacío o perdidos
+};
+
+class WorkStealer {
+    ThreadPool& pool_;
+    std::vector<std::unique_ptr<ChaseLevDeque>> deques_;
+    StealStats last_;
+
+public:
+    explicit WorkStealer(ThreadPool& pool = default_pool()) : pool_(pool) {}
+
+    // Contadores del último bucle
+    const StealStats& last_stats() const { return last_; }
+
+    // f(lo, hi, id) sobre trozos de [begin, end) de a lo sumo `grain`
+    // elementos (0 = automático); id es el participante que lo ejecuta, para
+    // indexar buffers privados
+    template <typename F>
+    void parallel_for(long long begin, long long end, int tasks, long long grain, const F& f) {
+        tasks = std::max(1, tasks);
+        if (grain <= 0) grain = std::max(1LL, (end - begin) / (tasks * WS_CHUNKS_PER_TASK));
+        while (static_cast<int>(deques_.size()) < tasks) deques_.push_back(std::make_unique<ChaseLevDeque>());
+
+        struct alignas(64) Counters {
+            StealStats stats;
+        };
+        std::vector<Counters> counters(tasks);
+        std::atomic<long long> remaining(end - begin);
+
+        pool_.run(tasks, [&](int id) {
+            ChaseLevDeque& own = *deques_[id];
+            StealStats& c = counters[id].stats;
+            uint64_t rng = 0x9E3779B97F4A7C15ull * static_cast<uint64_t>(id + 1);
+
+            StealRange r;
+            pool_chunk(begin, end, tasks, id, r.lo, r.hi);
+            bool have = r.lo < r.hi;
+            int idle = 0;
+            for (;;) {
+                while (have) {
+                    while (r.hi - r.lo > grain) {
+                        const long long mid = r.lo + (r.hi - r.lo) / 2;
+                        if (!own.push({mid, r.hi})) break;
+                        r.hi = mid;
+                    }
+                    f(r.lo, r.hi, id);
+                    ++c.chunks;
+                    remaining.fetch_sub(r.hi - r.lo, std::memory_order_acq_rel);
+                    have = own.take(r);
+                }
+                if (remaining.load(std::memory_order_acquire) == 0 || tasks == 1) break;
+
+                // Víctima al azar distinta de uno mismo (xorshift64)
+                rng ^= rng << 13;
+                rng ^= rng >> 7;
+                rng ^= rng << 17;
+                int victim = static_cast<int>(rng % static_cast<uint64_t>(tasks - 1));
+                if (victim >= id) ++victim;
+                if (deques_[victim]->steal(r) == ChaseLevDeque::Steal::Ok) {
+                    have = true;
+                    ++c.steals;
+                    idle = 0;
+                } else {
+                    ++c.failed_steals;
+                    // Espera escalonada: con más hilos que núcleos el dueño
+                    // del trabajo puede estar esperando la CPU que ocupa el
+                    // ladrón, y al final del bucle ya no queda qué robar
+                    if (++idle < WS_SPIN_STEALS) cpu_relax();
+                    else if (idle < WS_YIELD_STEALS) std::this_thread::yield();
+                    else std::this_thread::sleep_for(std::chrono::microseconds(WS_SLEEP_US));
+                }
+            }
+        });
+
+        last_ = StealStats();
+        for (const Counters& c : counters) {
+            last_.chunks += c.stats.chunks;
+            last_.steals += c.stats.steals;
+            last_.failed_steals += c.stats.failed_steals;
+        }
+    }
+
+    // map(lo, hi) -> T por trozo. Cada participante acumula sus trozos con
+    // combine y los parciales se combinan en orden de participante; qué
+    // trozos toca a cada uno depende de los robos, así que con double el
+    // redondeo puede variar entre ejecuciones
+    template <typename T, typename Map, typename Combine>
+    T parallel_reduce(long long begin, long long end, int tasks, long long grain, T identity,
+                      const Map& map, const Combine& combine) {
+        struct alignas(64) Partial {
+            T value;
+        };
+        std::vector<Partial> partials(std::max(1, tasks), Partial{identity});
+        parallel_for(begin, end, tasks, grain, [&](long long lo, long long hi, int id) {
+            partials[id].value = combine(partials[id].value, map(lo, hi));
+        });
+        T result = identity;
+        for (const Partial& p : partials) result = combine(result, p.value);
+        return result;
+    }
+};
+
+// Planificador compartido del programa (sobre default_pool())
+inline WorkStealer& default_stealer() {
+    static WorkStealer ws;
+    return ws;
+}
+
+// ============================================
+// CARGA DE FONDO
+// ============================================
+// Un hilo que gira sin parar mientras exista el objeto: simula otro
+// proceso que comparte la máquina y deja a uno de los hilos del kernel con
+// menos CPU que los demás. Se fija a `cpu` si existe (-1 = sin fijar).
+class BusySpinner {
+    std::atomic<bool> stop_{false};
+    pthread_t thread_;
+
+    static void* spin(void* arg) {
+        BusySpinner* s = static_cast<BusySpinner*>(arg);
+        while (!s->stop_.load(std::memory_order_relaxed)) cpu_relax();
+        return nullptr;
+    }
+
+public:
+    explicit BusySpinner(int cpu = 0) {
+        pthread_create(&thread_, nullptr, spin, this);
+        if (cpu >= 0 && cpu < static_cast<int>(std::thread::hardware_concurrency())) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(thread_, sizeof(set), &set);
+        }
+    }
+
+    ~BusySpinner() {
+        stop_.store(true, std::memory_order_relaxed);
+        pthread_join(thread_, nullptr);
+    }
+
+    BusySpinner(const BusySpinner&) = delete;
+    BusySpinner& operator=(const BusySpinner&) = delete;
+};
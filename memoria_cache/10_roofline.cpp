@@ -0,0 +1,151 @@
+// g++ -O3 -std=c++20 -pthread 10_roofline.cpp -o roofline && ./roofline [N]
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <string>
+#include <thread>
+
+#include "gemm_empaquetado.hpp"
+#include "gemm_paralelo.hpp"
+#include "gemv.hpp"
+#include "matvec.hpp"
+#include "autotuner.hpp"
+#include "../comun/benchmark.hpp"
+#include "../comun/roofline.hpp"
+
+using namespace std;
+
+// ============================================
+// MODELOS DE TRÁFICO (bytes desde memoria)
+// ============================================
+// Cotas del tráfico con memoria principal según el orden de los bucles,
+// suponiendo que lo que el kernel reutiliza dentro de un tile sí cabe en
+// caché y lo que no, no.
+
+// Clásico ijk: cada B(k, j) del producto punto viene de memoria (recorrido
+// por columnas sin reutilización); A y C una vez
+double bytes_classic(double N) {
+    return sizeof(real) * (N * N * N + 3.0 * N * N);
+}
+
+// Bloques ii -> jj -> kk: por cada par (ii, jj) se recorre una franja
+// bi x N de A y N x bj de B; C se lee y escribe una vez
+double bytes_blocked(double N, const BlockShape& s) {
+    return sizeof(real) * (N * N * N * (1.0 / s.bi + 1.0 / s.bj) + 2.0 * N * N);
+}
+
+// Empaquetado: B se empaqueta una vez, A una vez por panel NC de B, y C se
+// lee y escribe una vez por panel KC
+double bytes_packed(double N) {
+    return sizeof(real) * N * N * (1.0 + std::ceil(N / NC) + 2.0 * std::ceil(N / KC));
+}
+
+// GEMV m x n con k vectores: A una vez, X leído e Y escrito
+double bytes_gemv(double m, double n, double k) {
+    return sizeof(real) * (m * n + (m + n) * k);
+}
+
+double flops_gemm(double N) { return 2.0 * N * N * N; }
+double flops_gemv(double m, double n, double k) { return 2.0 * m * n * k; }
+
+void report(const string& title, const vector<RooflinePoint>& points, const Ceilings& c,
+            const string& csv) {
+    cout << "\n=== " << title << " ===\n";
+    print_ceilings(c);
+    cout << left << setw(25) << "Kernel" << right << setw(12) << "FLOP/byte"
+         << setw(11) << "Tiempo(s)" << setw(10) << "GFLOP/s" << setw(10) << "Techo"
+         << setw(8) << "%" << setw(10) << "Limite" << "\n";
+    cout << string(86, '-') << "\n";
+    for (const RooflinePoint& p : points) {
+        double roof = c.attainable(p.intensity());
+        cout << left << setw(25) << p.name << right << fixed
+             << setw(12) << setprecision(3) << p.intensity()
+             << setw(11) << setprecision(4) << p.seconds
+             << setw(10) << setprecision(2) << p.gflops()
+             << setw(10) << roof
+             << setw(7) << setprecision(1) << p.gflops() / roof * 100 << "%"
+             << setw(10) << c.bound(p.intensity(), p.gflops()) << "\n";
+    }
+    cout << string(86, '-') << "\n";
+
+    print_roofline_chart(points, c);
+    print_roofline_bars(points, c);
+    write_roofline_csv(points, c, csv);
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    const size_t N = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : 512;
+    const size_t M_GEMV = 2000, K_LOTE = 8;
+    const int num_threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+
+    mt19937_64 rng(123456);
+    Matrix<real> A(N), B(N), C(N);
+    fill_uniform(A.view(), rng);
+    fill_uniform(B.view(), rng);
+
+    Matrix<real> G(M_GEMV), X(M_GEMV, K_LOTE), Y(M_GEMV, K_LOTE);
+    fill_uniform(G.view(), rng);
+    fill_uniform(X.view(), rng);
+    vector<real> x(M_GEMV, 1.0), y(M_GEMV);
+    auto zero_y = [&]() { fill(y.begin(), y.end(), 0.0); };
+
+    cout << "=== ROOFLINE: GEMM N = " << N << ", GEMV " << M_GEMV << "x" << M_GEMV << " ===\n";
+    cout << "Midiendo techos de la máquina...\n";
+    Ceilings c1 = probe_ceilings(1);
+
+    const string prefix = "N=" + to_string(N) + "/";
+    const BlockShape tuned = tuned_block_shape(N);
+    const BlockShape tile32 = {32, 32, 32};
+    const double n = double(N), m = double(M_GEMV);
+
+    // Un hilo: contra los techos de un núcleo
+    vector<RooflinePoint> points;
+    auto add = [&](const string& name, double flops, double bytes, const BenchStats& st) {
+        points.push_back({name, flops, bytes, st.median});
+    };
+
+    add("Clasico", flops_gemm(n), bytes_classic(n),
+        run_benchmark_setup(prefix + "clasico", [&]() { C.fill(0.0); }, [&]() { matmul_classic(A, B, C); }));
+    add("Bloques 32", flops_gemm(n), bytes_blocked(n, tile32),
+        run_benchmark(prefix + "bloques/32", [&]() { matmul_blocked(A, B, C, tile32); }));
+    if (shape_label(tuned) != shape_label(tile32))
+        add("Bloques " + shape_label(tuned), flops_gemm(n), bytes_blocked(n, tuned),
+            run_benchmark(prefix + "autotuneado/" + shape_label(tuned), [&]() { matmul_blocked(A, B, C, tuned); }));
+    add("Empaquetado", flops_gemm(n), bytes_packed(n),
+        run_benchmark(prefix + "empaquetado", [&]() { matmul_packed(A, B, C); }));
+    add("GEMV filas", flops_gemv(m, m, 1), bytes_gemv(m, m, 1),
+        run_benchmark_setup("gemv/filas", zero_y, [&]() { matvec_by_rows(G.view(), x.data(), y.data()); }));
+    add("GEMV columnas", flops_gemv(m, m, 1), bytes_gemv(m, m, 1),
+        run_benchmark_setup("gemv/columnas", zero_y, [&]() { matvec_by_columns(G.view(), x.data(), y.data()); }));
+    add("GEMV SIMD", flops_gemv(m, m, 1), bytes_gemv(m, m, 1),
+        run_benchmark("gemv/simd", [&]() { gemv(G, x.data(), y.data()); }));
+    add("GEMV lote k=" + to_string(K_LOTE), flops_gemv(m, m, K_LOTE), bytes_gemv(m, m, K_LOTE),
+        run_benchmark("gemv/lote", [&]() { gemv_batched(G, X, Y); }));
+
+    report("UN HILO", points, c1, "roofline.csv");
+
+    // Varios hilos: contra los techos medidos con el mismo número de hilos
+    if (num_threads > 1) {
+        Ceilings cn = probe_ceilings(num_threads);
+        points.clear();
+        add("Empaquetado " + to_string(num_threads) + " hilos", flops_gemm(n), bytes_packed(n),
+            run_benchmark(prefix + "paralelo", [&]() { matmul_parallel(A, B, C, num_threads); }));
+        add("GEMV " + to_string(num_threads) + " hilos", flops_gemv(m, m, 1), bytes_gemv(m, m, 1),
+            run_benchmark("gemv/hilos", [&]() { gemv_parallel(G, x.data(), y.data(), num_threads); }));
+        add("GEMV lote " + to_string(num_threads) + " hilos", flops_gemv(m, m, K_LOTE), bytes_gemv(m, m, K_LOTE),
+            run_benchmark("gemv/lote_hilos", [&]() { gemv_batched_parallel(G, X, Y, num_threads); }));
+
+        report(to_string(num_threads) + " HILOS", points, cn, "roofline_hilos.csv");
+    }
+
+    cout << "\nIntensidad: FLOPs / bytes del modelo de tráfico de cada kernel\n";
+    cout << "Limite 'cache': supera el techo de memoria porque sus datos caben en la LLC\n";
+    save_bench_report("10_roofline");
+    return 0;
+}
@@ -0,0 +1,184 @@
+// g++ -O3 -std=c++20 -pthread 11_simulador_cache.cpp -o simulador && ./simulador [n=512] [relleno=0] [politica=lru|plru] [linea=64] [l1=48K/12] [l2=2M/16] [l3=30M/20] [bloques=16,32,64,128] [hilos=núcleos]
+// Build instrumentado: los accesos de los kernels van al simulador de caché
+#define TRAZA_CACHE
+
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <sstream>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "gemm_bloques.hpp"
+#include "matvec.hpp"
+#include "simulador_cache.hpp"
+#include "../comun/thread_pool.hpp"
+
+using namespace std;
+
+// ============================================
+// CONFIGURACIÓN (argumentos clave=valor)
+// ============================================
+struct SimConfig {
+    size_t N = 512;
+    size_t padding = 0;  // elementos extra por fila (ld = N + relleno)
+    Replacement policy = Replacement::LRU;
+    vector<CacheLevel> levels;
+    vector<size_t> blocks = {16, 32, 64, 128};
+    int threads = max(1, static_cast<int>(thread::hardware_concurrency()));
+};
+
+// "48K/12" -> tamaño y asociatividad
+CacheLevel parse_level(int level, const string& text, size_t line) {
+    size_t slash = text.find('/');
+    if (slash == string::npos) throw invalid_argument("se esperaba tamaño/vías: " + text);
+    return {level, parse_cache_size(text.substr(0, slash)), line, stoull(text.substr(slash + 1))};
+}
+
+SimConfig parse_args(int argc, char* argv[]) {
+    // Por defecto la geometría de la máquina
+    const CpuInfo& cpu = detect_cpu_info();
+    SimConfig cfg;
+    size_t line = cpu.l1d.line_size;
+    CacheLevel levels[3] = {cpu.l1d, cpu.l2, cpu.l3};
+    for (CacheLevel& l : levels)
+        if (l.ways == 0) l.ways = 8;
+
+    vector<pair<int, string>> overrides;
+    for (int a = 1; a < argc; ++a) {
+        string arg = argv[a];
+        size_t eq = arg.find('=');
+        string key = arg.substr(0, eq), value = eq == string::npos ? "" : arg.substr(eq + 1);
+        if (key == "n") cfg.N = stoull(value);
+        else if (key == "relleno") cfg.padding = stoull(value);
+        else if (key == "politica" && (value == "lru" || value == "plru"))
+            cfg.policy = value == "plru" ? Replacement::PLRU : Replacement::LRU;
+        else if (key == "linea") line = stoull(value);
+        else if (key == "l1" || key == "l2" || key == "l3") overrides.push_back({key[1] - '0', value});
+        else if (key == "bloques") {
+            cfg.blocks.clear();
+            stringstream ss(value);
+            string b;
+            while (getline(ss, b, ',')) cfg.blocks.push_back(stoull(b));
+        } else if (key == "hilos") {
+            cfg.threads = max(1, stoi(value));
+        } else {
+            throw invalid_argument("argumento desconocido: " + arg);
+        }
+    }
+    for (CacheLevel& l : levels) l.line_size = line;
+    for (const auto& [level, text] : overrides) levels[level - 1] = parse_level(level, text, line);
+    cfg.levels.assign(levels, levels + 3);
+    return cfg;
+}
+
+// ============================================
+// REPORTE
+// ============================================
+void print_report(const CacheSimulator& sim, const vector<CacheRegionStats>& regions,
+                  const vector<double>& seconds) {
+    const size_t num_levels = sim.config().size();
+    cout << "\n" << left << setw(22) << "Nido de bucles" << right << setw(14) << "Accesos";
+    for (size_t l = 0; l < num_levels; ++l)
+        cout << setw(13) << string("L").append(to_string(l + 1)).append(" fallos") << setw(8) << "%";
+    cout << setw(12) << "MB memoria" << setw(10) << "Sim(s)" << "\n";
+    const size_t width = 22 + 14 + 21 * num_levels + 22;
+    cout << string(width, '-') << "\n";
+
+    for (size_t r = 0; r < regions.size(); ++r) {
+        const CacheRegionStats& reg = regions[r];
+        cout << left << setw(22) << reg.name << right << setw(14) << reg.accesses;
+        for (size_t l = 0; l < num_levels; ++l)
+            cout << setw(13) << setprecision(0) << reg.estimated_misses(l) << setw(7) << setprecision(2)
+                 << reg.miss_rate(l) * 100 << "%";
+        double mb = reg.estimated_misses(num_levels - 1) * sim.line_size() / (1 << 20);
+        cout << setw(12) << setprecision(1) << mb << setw(10) << setprecision(2) << seconds[r] << "\n";
+    }
+    cout << string(width, '-') << "\n";
+    cout << "%: fallos / accesos que llegan a ese nivel; MB memoria: fallos del último nivel x línea\n";
+    for (size_t l = 0; l < num_levels; ++l)
+        if (sim.sample(l) > 1)
+            cout << "L" << l + 1 << ": simulado en 1 de cada " << sim.sample(l)
+                 << " conjuntos; sus fallos son una estimación\n";
+}
+
+int main(int argc, char* argv[]) {
+    SimConfig cfg;
+    try {
+        cfg = parse_args(argc, argv);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+
+    const size_t N = cfg.N;
+    // Solo para la geometría del encabezado y del reporte: cada nido simula
+    // con el suyo
+    CacheSimulator sim(cfg.levels, cfg.policy);
+
+    cout << "=== SIMULADOR DE CACHÉ: N = " << N << " (ld = " << N + cfg.padding << "), reemplazo "
+         << replacement_name(cfg.policy) << ", línea de " << sim.line_size() << " B ===\n";
+    for (const CacheLevel& l : cfg.levels)
+        cout << "L" << l.level << ": " << l.size / 1024 << " KB, " << l.ways << " vías\n";
+
+    // Con N potencia de 2 las filas de una columna caen en el mismo conjunto;
+    // el relleno (ld > N) las reparte
+    const size_t ld = N + cfg.padding;
+    Matrix<real> A(N, N, ld), B(N, N, ld);
+    Matrix<real, Layout::ColMajor> A_col(N, N, ld);
+    vector<real> x(N, 1.0);
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+            A(i, j) = A_col(i, j) = real(i + j) / N;
+            B(i, j) = real(i) - real(j);
+        }
+    }
+
+    // Los kernels escriben en C o en y, que pone cada nido
+    struct Nest {
+        string name;
+        function<void(Matrix<real>& C, vector<real>& y)> kernel;
+    };
+    vector<Nest> nests = {
+        {"matvec filas", [&](Matrix<real>&, vector<real>& y) { matvec_by_rows(A.view(), x.data(), y.data()); }},
+        {"matvec columnas", [&](Matrix<real>&, vector<real>& y) { matvec_by_columns(A.view(), x.data(), y.data()); }},
+        {"matvec col-major fil.", [&](Matrix<real>&, vector<real>& y) { matvec_by_rows(A_col.view(), x.data(), y.data()); }},
+        {"clasico", [&](Matrix<real>& C, vector<real>&) { matmul_classic(A, B, C); }},
+    };
+    for (size_t b : cfg.blocks) {
+        if (b > N) continue;
+        nests.push_back({"bloques " + to_string(b), [&, b](Matrix<real>& C, vector<real>&) { matmul_blocked(A, B, C, b); }});
+    }
+
+    // Cada nido escribe en su propia salida, reservada antes de empezar:
+    // sus direcciones (y los fallos por conflicto con A y B) no dependen de
+    // cuántos hilos haya
+    vector<Matrix<real>> outputs;
+    for (size_t t = 0; t < nests.size(); ++t) outputs.emplace_back(N, N, ld);
+    vector<vector<real>> ys(nests.size(), vector<real>(N, 0.0));
+
+    // Los nidos son independientes: cada hilo toma el siguiente y lo simula
+    // con su propio simulador (cachés vacías). A, B y x solo se leen
+    vector<CacheRegionStats> regions(nests.size());
+    vector<double> seconds(nests.size());
+    atomic<size_t> next(0);
+    default_pool().run(min<int>(cfg.threads, static_cast<int>(nests.size())), [&](int) {
+        for (size_t t = next.fetch_add(1); t < nests.size(); t = next.fetch_add(1)) {
+            CacheSimulator nest_sim(cfg.levels, cfg.policy);
+            auto start = chrono::steady_clock::now();
+            {
+                TraceRegion region(nest_sim, nests[t].name);
+                nests[t].kernel(outputs[t], ys[t]);
+            }
+            seconds[t] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+            regions[t] = nest_sim.regions()[0];
+        }
+    });
+
+    cout << fixed;
+    print_report(sim, regions, seconds);
+    return 0;
+}
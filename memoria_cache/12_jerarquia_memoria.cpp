@@ -0,0 +1,258 @@
+// g++ -O3 -std=c++20 -pthread 12_jerarquia_memoria.cpp -o jerarquia && ./jerarquia [max_MB=1024]
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <thread>
+
+#include "jerarquia_memoria.hpp"
+#include "bloques_multinivel.hpp"
+
+using namespace std;
+
+// "4 KB", "1.5 MB", "1 GB"
+string format_bytes(size_t bytes) {
+    const char* units[] = {"B", "KB", "MB", "GB"};
+    double value = double(bytes);
+    int u = 0;
+    while (value >= 1024.0 && u < 3) {
+        value /= 1024.0;
+        ++u;
+    }
+    ostringstream out;
+    out << setprecision(value < 10.0 ? 2 : 4) << value << " " << units[u];
+    return out.str();
+}
+
+// Mediana del ancho de banda de los puntos de una meseta
+double plateau_bandwidth(const vector<double>& gbs, const MemoryStep& step) {
+    vector<double> values;
+    for (size_t k = step.first; k <= step.last && k < gbs.size(); ++k)
+        if (gbs[k] > 0.0) values.push_back(gbs[k]);
+    if (values.empty()) return 0.0;
+    nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+struct CsvRow {
+    string test;
+    int threads;
+    size_t bytes, stride;
+    double latency_ns, gbs, line_gbs;
+};
+
+void write_csv(const vector<CsvRow>& rows, const string& filename) {
+    ofstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error: No se pudo abrir " << filename << " para escribir resultados\n";
+        return;
+    }
+    file << "Prueba,Hilos,Tamano_bytes,Stride_bytes,Latencia_ns,GB_s,GB_s_lineas\n";
+    for (const CsvRow& r : rows) {
+        file << r.test << "," << r.threads << "," << r.bytes << "," << r.stride << ",";
+        if (r.latency_ns > 0.0) file << r.latency_ns;
+        file << ",";
+        if (r.gbs > 0.0) file << r.gbs << "," << r.line_gbs;
+        else file << ",";
+        file << "\n";
+    }
+    cout << "Resultados guardados en: " << filename << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    const CpuInfo& cpu = detect_cpu_info();
+    const size_t line = cpu.l1d.line_size, page = page_size();
+    const int max_threads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+    vector<int> thread_counts = {1};
+    if (max_threads > 1) thread_counts.push_back(max_threads);
+
+    // Conjunto de trabajo máximo: el pedido, sin pasar de la mitad de la memoria libre
+    size_t max_bytes = (argc > 1 ? stoull(argv[1]) : 1024) << 20;
+    const size_t available = available_memory();
+    if (available > 0 && max_bytes > available / 2) {
+        size_t capped = 4096;
+        while (capped * 2 <= available / 2) capped *= 2;
+        cout << "(memoria libre " << format_bytes(available) << ": el barrido llega a "
+             << format_bytes(capped) << ")\n";
+        max_bytes = capped;
+    }
+
+    cout << "=== JERARQUÍA DE MEMORIA: 4 KB a " << format_bytes(max_bytes) << ", línea de " << line
+         << " B, páginas de " << format_bytes(page) << " ===\n\n";
+    cout << "CPU: " << cpu.model << "\n";
+    const CacheLevel* levels[3] = {&cpu.l1d, &cpu.l2, &cpu.l3};
+    cout << "sysfs: L1d " << format_bytes(cpu.l1d.size) << ", L2 " << format_bytes(cpu.l2.size)
+         << ", L3 " << format_bytes(cpu.l3.size) << "\n";
+
+    const vector<size_t> sizes = hierarchy_sizes(4 * 1024, max_bytes);
+    vector<CsvRow> csv;
+    vector<CurvePoint> curve;
+    vector<vector<double>> read_gbs(thread_counts.size()), write_gbs(thread_counts.size());
+
+    {
+        aligned_array<char> buffer = make_page_buffer(max_bytes, true);
+        memset(buffer.get(), 0, max_bytes);
+
+        // ============================================
+        // LATENCIA
+        // ============================================
+        cout << "\n--- Latencia (persecución de punteros, orden aleatorio) ---\n";
+        cout << setw(12) << "Tamano" << setw(14) << "ns/acceso" << "\n";
+        cout << string(26, '-') << "\n";
+        cout << fixed;
+        for (size_t s : sizes) {
+            void* start = line_chase_cycle(buffer.get(), s, line);
+            double ns = measure_latency_ns("latencia/" + to_string(s), start);
+            curve.push_back({s, ns});
+            csv.push_back({"latencia", 1, s, line, ns, 0.0, 0.0});
+            cout << setw(12) << format_bytes(s) << setw(14) << setprecision(2) << ns << "\n";
+        }
+
+        // ============================================
+        // ANCHO DE BANDA SECUENCIAL
+        // ============================================
+        cout << "\n--- Ancho de banda secuencial (GB/s; tamaño por hilo) ---\n";
+        cout << setw(12) << "Tamano";
+        for (int t : thread_counts)
+            cout << setw(11) << string("Lect ").append(to_string(t)).append("h")
+                 << setw(11) << string("Escr ").append(to_string(t)).append("h");
+        cout << "\n" << string(12 + 22 * thread_counts.size(), '-') << "\n";
+        for (size_t s : sizes) {
+            cout << setw(12) << format_bytes(s);
+            for (size_t c = 0; c < thread_counts.size(); ++c) {
+                const int t = thread_counts[c];
+                double r = 0.0, w = 0.0;
+                if (s * t <= max_bytes) {
+                    const string suffix = string("/").append(to_string(t)).append("h/").append(to_string(s));
+                    r = measure_bandwidth("lectura" + suffix, buffer.get(), s, 8, StreamOp::Read, t, line).useful_gbs;
+                    w = measure_bandwidth("escritura" + suffix, buffer.get(), s, 8, StreamOp::Write, t, line).useful_gbs;
+                    csv.push_back({"lectura", t, s, 8, 0.0, r, r});
+                    csv.push_back({"escritura", t, s, 8, 0.0, w, w});
+                }
+                read_gbs[c].push_back(r);
+                write_gbs[c].push_back(w);
+                if (r > 0.0) cout << setw(11) << setprecision(1) << r << setw(11) << w;
+                else cout << setw(11) << "-" << setw(11) << "-";
+            }
+            cout << "\n";
+        }
+
+        // ============================================
+        // ANCHO DE BANDA CON PASO
+        // ============================================
+        // Sobre un buffer que no cabe en la LLC: desde 64 B cada acceso trae
+        // una línea entera y desde 4 KB además cruza una página
+        const size_t strided_bytes = min(max_bytes, max<size_t>(256 << 20, 2 * cpu.l3.size));
+        cout << "\n--- Ancho de banda con paso sobre " << format_bytes(strided_bytes)
+             << " (GB/s útiles / GB/s de líneas) ---\n";
+        cout << setw(8) << "Paso";
+        for (int t : thread_counts)
+            cout << setw(20) << string("Lectura ").append(to_string(t)).append("h")
+                 << setw(20) << string("Escritura ").append(to_string(t)).append("h");
+        cout << "\n" << string(8 + 40 * thread_counts.size(), '-') << "\n";
+        for (size_t stride = 8; stride <= 8192; stride *= 2) {
+            cout << setw(8) << stride;
+            for (int t : thread_counts) {
+                const size_t per_thread = strided_bytes / t / 4096 * 4096;
+                for (StreamOp op : {StreamOp::Read, StreamOp::Write}) {
+                    const string name = string(stream_op_name(op)) + "_paso/" + to_string(t) + "h/" + to_string(stride);
+                    BandwidthResult b = measure_bandwidth(name, buffer.get(), per_thread, stride, op, t, line);
+                    csv.push_back({string(stream_op_name(op)) + "_paso", t, per_thread * t, stride, 0.0,
+                                   b.useful_gbs, b.line_gbs});
+                    ostringstream cell;
+                    cell << fixed << setprecision(2) << b.useful_gbs << " / " << setprecision(1) << b.line_gbs;
+                    cout << setw(20) << cell.str();
+                }
+            }
+            cout << "\n";
+        }
+    }
+
+    // ============================================
+    // TLB
+    // ============================================
+    // Páginas de 4 KB (sin páginas grandes) y una línea por página: hasta
+    // que los datos desbordan L1 (una línea por página) cada escalón es de TLB
+    const size_t max_pages = max_bytes / page;
+    vector<CurvePoint> tlb_curve;
+    {
+        aligned_array<char> buffer = make_page_buffer(max_pages * page, false);
+        memset(buffer.get(), 0, max_pages * page);
+        for (size_t pages : hierarchy_sizes(4, max_pages)) {
+            void* start = page_chase_cycle(buffer.get(), pages, page, line);
+            double ns = measure_latency_ns("tlb/" + to_string(pages), start);
+            tlb_curve.push_back({pages, ns});
+            csv.push_back({"tlb", 1, pages * page, page, ns, 0.0, 0.0});
+        }
+    }
+    cout << "\n--- TLB (un acceso por página de " << format_bytes(page) << ") ---\n";
+    cout << setw(10) << "Paginas" << setw(12) << "Alcance" << setw(14) << "ns/acceso" << "\n";
+    cout << string(36, '-') << "\n";
+    for (const CurvePoint& p : tlb_curve)
+        cout << setw(10) << p.bytes << setw(12) << format_bytes(p.bytes * page)
+             << setw(14) << setprecision(2) << p.latency_ns << "\n";
+    // Una línea por página: desde tantas páginas como líneas tiene L1 el
+    // escalón también puede ser de caché de datos
+    const vector<MemoryStep> steps = detect_steps(curve);
+    const size_t l1_bytes = steps.size() > 1 ? steps[0].capacity : cpu.l1d.size;
+    const size_t l1_lines = l1_bytes / line;
+    const vector<MemoryStep> tlb_steps = detect_steps(tlb_curve);
+    for (const MemoryStep& s : tlb_steps) {
+        if (s.capacity == 0) break;
+        cout << "Escalón tras " << s.capacity << " páginas (alcance " << format_bytes(s.capacity * page)
+             << ", " << s.latency_ns << " ns)";
+        if (s.capacity >= l1_lines) cout << "  [los datos ya no caben en L1]";
+        cout << "\n";
+    }
+
+    // ============================================
+    // NIVELES DETECTADOS
+    // ============================================
+    cout << "\n--- Niveles detectados en la curva de latencia ---\n";
+    cout << left << setw(7) << "Nivel" << right << setw(12) << "Medido" << setw(12) << "sysfs"
+         << setw(14) << "Latencia(ns)";
+    for (int t : thread_counts)
+        cout << setw(11) << string("Lect ").append(to_string(t)).append("h")
+             << setw(11) << string("Escr ").append(to_string(t)).append("h");
+    cout << "\n" << string(45 + 22 * thread_counts.size(), '-') << "\n";
+    CpuInfo measured = cpu;
+    CacheLevel* measured_levels[3] = {&measured.l1d, &measured.l2, &measured.l3};
+    int cache_level = 0;
+    for (const MemoryStep& s : steps) {
+        const bool dram = s.capacity == 0;
+        string name = dram ? "DRAM" : string("L").append(to_string(cache_level + 1));
+        cout << left << setw(7) << name << right << setw(12) << (dram ? "-" : format_bytes(s.capacity))
+             << setw(12) << (!dram && cache_level < 3 ? format_bytes(levels[cache_level]->size) : "-")
+             << setw(14) << setprecision(2) << s.latency_ns;
+        for (size_t c = 0; c < thread_counts.size(); ++c)
+            cout << setw(11) << setprecision(1) << plateau_bandwidth(read_gbs[c], s)
+                 << setw(11) << plateau_bandwidth(write_gbs[c], s);
+        cout << "\n";
+        if (!dram && cache_level < 3) measured_levels[cache_level]->size = s.capacity;
+        if (!dram) ++cache_level;
+    }
+    if (!steps.empty() && steps.back().capacity == 0 && curve.back().bytes <= cpu.l3.size)
+        cout << "(el barrido no pasa de L3: la última meseta puede no ser DRAM)\n";
+
+    // Tiles de 6_bloques_multinivel con las capacidades medidas
+    const MultiLevelTiling from_sysfs = tiling_from_caches(cpu);
+    const MultiLevelTiling from_measure = tiling_from_caches(measured);
+    cout << "\nTiles de bloques_multinivel.hpp (sysfs -> medidos):";
+    for (int l = 0; l < 3; ++l)
+        cout << "  L" << l + 1 << " " << shape_label(from_sysfs.levels[l]) << " -> "
+             << shape_label(from_measure.levels[l]);
+    cout << "\n";
+    cout << "Medido: último tamaño de la meseta (resolución de 1.5x); GB/s: mediana de la meseta\n";
+    cout << "Los niveles que no aparecen en la curva quedan con el tamaño de sysfs\n\n";
+
+    write_csv(csv, "jerarquia_memoria.csv");
+    save_bench_report("12_jerarquia_memoria");
+    return 0;
+}
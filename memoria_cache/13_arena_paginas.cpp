@@ -0,0 +1,152 @@
+// g++ -O3 -std=c++20 -pthread 13_arena_paginas.cpp -o arena && ./arena [max_N=2048]
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <string>
+#include <functional>
+
+#include "arena.hpp"
+#include "cpu_info.hpp"
+#include "gemm_bloques.hpp"
+#include "../comun/benchmark.hpp"
+#include "../comun/perf_counters.hpp"
+
+using namespace std;
+
+// Inicializar matrices con valores aleatorios
+void init_matrices(RealView A, RealView B, mt19937_64& rng) {
+    uniform_real_distribution<real> dist(0.0, 1.0);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+}
+
+// Suma por columnas: cada acceso cae en otra fila, es decir, en otra página
+// de 4 KB en cuanto una fila ocupa 4 KB (N >= 512). Es el recorrido de B en
+// el producto clásico, sin las operaciones que lo tapan
+real column_sums(ConstRealView B) {
+    real total = 0.0;
+    for (size_t j = 0; j < B.cols(); ++j)
+        for (size_t i = 0; i < B.rows(); ++i)
+            total += B(i, j);
+    return total;
+}
+
+// Origen de las tres matrices de un tamaño
+struct Storage {
+    string name;
+    function<void(size_t, RealView&, RealView&, RealView&)> prepare;
+};
+
+string counter(const PerfSample& s, int e) {
+    return s.has(e) ? to_string(static_cast<long long>(s.value[e])) : "-";
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    const size_t max_n = argc > 1 ? stoul(argv[1]) : 2048;
+    vector<size_t> sizes;
+    for (size_t n = 512; n <= max_n; n *= 2) sizes.push_back(n);
+    const size_t tile = 64;
+    const size_t max_bytes = 3 * max_n * max_n * sizeof(real);
+
+    PerfCounters perf;
+    mt19937_64 rng(123456);
+
+    cout << "=== MATRICES EN ARENA CON PÁGINAS GRANDES vs std::vector ===\n\n";
+    cout << "THP: " << read_first_line("/sys/kernel/mm/transparent_hugepage/enabled")
+         << "   vm.nr_hugepages: " << read_first_line("/proc/sys/vm/nr_hugepages") << "\n";
+    if (!perf.available())
+        cout << "Contadores de hardware no disponibles (" << perf.error() << "): dTLB queda en '-'\n";
+
+    // std::vector: memoria nueva y en cero para cada tamaño, como los
+    // programas antes de la arena
+    vector<real> va, vb, vc;
+    vector<Storage> storages;
+    storages.push_back({"std::vector", [&](size_t n, RealView& A, RealView& B, RealView& C) {
+        va = vector<real>(n * n);
+        vb = vector<real>(n * n);
+        vc = vector<real>(n * n);
+        A = RealView(va.data(), n, n);
+        B = RealView(vb.data(), n, n);
+        C = RealView(vc.data(), n, n);
+    }});
+
+    // Una arena por modo de página, reservada para el tamaño más grande
+    vector<unique_ptr<MatrixArena>> arenas;
+    for (PageMode mode : {PageMode::Small, PageMode::Transparent, PageMode::HugeTLB}) {
+        auto arena = make_unique<MatrixArena>(mode);
+        arena->reserve(max_bytes);
+        if (arena->mode() != mode) {
+            cout << "arena " << page_mode_name(mode) << ": no disponible (queda en "
+                 << page_mode_name(arena->mode()) << "), se omite\n";
+            continue;
+        }
+        MatrixArena* a = arena.get();
+        storages.push_back({string("arena ").append(page_mode_name(mode)),
+                            [a](size_t n, RealView& A, RealView& B, RealView& C) {
+            a->reset();
+            A = a->matrix(n, n);
+            B = a->matrix(n, n);
+            C = a->matrix(n, n);
+        }});
+        arenas.push_back(std::move(arena));
+    }
+
+    cout << "\nPreparación: obtener A, B y C (la segunda vez, con la arena ya en uso)\n";
+    cout << "Columnas: suma por columnas de B; Bloques: matmul_blocked con tile " << tile << "\n\n";
+    cout << setw(6) << "N" << "  " << left << setw(14) << "Memoria" << right << setw(11) << "Prep(ms)"
+         << setw(12) << "Fallos pag" << setw(11) << "Col(ms)" << setw(13) << "dTLB col"
+         << setw(11) << "Bloques(s)" << setw(13) << "dTLB bloques" << "\n";
+    cout << string(93, '-') << "\n";
+
+    for (size_t N : sizes) {
+        const string prefix = "N=" + to_string(N) + "/";
+        for (const Storage& st : storages) {
+            RealView A, B, C;
+            st.prepare(N, A, B, C);
+            init_matrices(A, B, rng);
+
+            // Preparación en régimen: con la arena no hay memoria nueva ni
+            // fallos de página; con vector cada tamaño vuelve a pedirla
+            BenchStats prep = run_benchmark(prefix + st.name + "/preparacion", [&]() {
+                st.prepare(N, A, B, C);
+                C.fill(0.0);
+            });
+            PerfSample prep_counters = measure_counters(perf, [&]() {
+                st.prepare(N, A, B, C);
+                C.fill(0.0);
+            });
+            init_matrices(A, B, rng);
+
+            real sink = 0.0;
+            BenchStats cols = run_benchmark(prefix + st.name + "/columnas", [&]() { sink += column_sums(B); });
+            PerfSample col_counters = measure_counters(perf, [&]() { sink += column_sums(B); });
+            do_not_optimize(sink);
+
+            BenchStats blocked = run_benchmark(prefix + st.name + "/bloques", [&]() { matmul_blocked(A, B, C, tile); });
+            PerfSample blocked_counters = measure_counters(perf, [&]() { matmul_blocked(A, B, C, tile); });
+
+            cout << setw(6) << N << "  " << left << setw(14) << st.name << right << fixed
+                 << setw(11) << setprecision(2) << prep.median * 1e3
+                 << setw(12) << counter(prep_counters, PERF_PAGE_FAULTS)
+                 << setw(11) << cols.median * 1e3
+                 << setw(13) << counter(col_counters, PERF_DTLB_MISSES)
+                 << setw(11) << setprecision(3) << blocked.median
+                 << setw(13) << counter(blocked_counters, PERF_DTLB_MISSES) << "\n";
+        }
+        cout << string(93, '-') << "\n";
+    }
+    cout << "Fallos pag: fallos de página de una preparación (contador de software);\n"
+         << "dTLB: fallos de carga en el dTLB de una ejecución del kernel\n";
+
+    save_bench_report("13_arena_paginas");
+    return 0;
+}
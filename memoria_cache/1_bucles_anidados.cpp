@@ -1,52 +1,218 @@
 #include <iostream>
 #include <vector>
-#include <chrono>
+#include <iomanip>
+#include <random>
+#include <cmath>
+#include <string>
+#include <thread>
+
+#include "matriz.hpp"
+#include "spmv.hpp"
+#include "gemv.hpp"
+#include "matvec.hpp"
+#include "../comun/benchmark.hpp"
 
 using namespace std;
-using namespace std::chrono;
 
 const int MAX = 2000;
 
-double A[MAX][MAX];
+// Representación anterior: arreglo global de tamaño fijo
+double A_old[MAX][MAX];
 double x[MAX], y[MAX];
 
+// Primer par de bucles (i externo, recorre A por filas) y segundo (j
+// externo, por columnas): matvec_by_rows y matvec_by_columns de matvec.hpp
+
+// Acceso A(i, j) sobre el arreglo global para reutilizar los mismos kernels
+struct ArregloGlobal {
+    double operator()(size_t i, size_t j) const { return A_old[i][j]; }
+    size_t rows() const { return MAX; }
+    size_t cols() const { return MAX; }
+};
+
+// Mediana en ms de un kernel, con y = 0 antes de cada ejecución (fuera de la medición)
+template <typename Kernel>
+double medir_ms(const string& name, Kernel kernel) {
+    return run_benchmark_setup(name, [] {
+        for (int i = 0; i < MAX; i++)
+            y[i] = 0.0;
+    }, kernel).median * 1e3;
+}
+
+// GB/s efectivos: bytes que el kernel tiene que mover / tiempo
+double gbps(double bytes, double ms) {
+    return bytes / (ms * 1e6);
+}
+
+// Bytes del matvec denso: A completa, x leído e y escrito
+const double DENSE_BYTES = (double(MAX) * MAX + 2.0 * MAX) * sizeof(double);
+
+// Benchmark de SpMV para una matriz: CSR (1 y varios hilos), ELL y SELL-C-sigma
+void benchmark_spmv(const string& name, const CooMatrix& coo, size_t num_threads) {
+    const size_t chunk = 8, sigma = 256;
+
+    CsrMatrix csr = coo_to_csr(coo);
+    vector<real> xs(csr.cols, 1.0), y_ref(csr.rows), ys(csr.rows);
+    spmv_csr(csr, xs.data(), y_ref.data());
+
+    auto max_diff = [&]() {
+        double diff = 0.0;
+        for (size_t i = 0; i < csr.rows; i++)
+            diff = max(diff, fabs(ys[i] - y_ref[i]));
+        return diff;
+    };
+    auto print_row = [&](const string& format, double ms, double bytes, double padding, double err) {
+        cout << left << setw(12) << name << setw(16) << format << right
+             << setw(10) << ms << setw(10) << gbps(bytes, ms)
+             << setw(10) << padding
+             << setw(11) << scientific << setprecision(1) << err
+             << fixed << setprecision(2) << "\n";
+    };
+
+    double ms = medir_ms(name + "/csr", [&] { spmv_csr(csr, xs.data(), ys.data()); });
+    print_row("CSR", ms, spmv_bytes(csr), 1.0, max_diff());
+
+    vector<size_t> bounds = partition_rows_by_nnz(csr, num_threads);
+    ms = medir_ms(name + "/csr_hilos", [&] { spmv_csr_parallel(csr, xs.data(), ys.data(), bounds); });
+    print_row("CSR " + to_string(num_threads) + " hilos", ms, spmv_bytes(csr), 1.0, max_diff());
+
+    // ELL rellena todas las filas hasta la más larga; con filas muy
+    // desiguales no cabe en memoria y se omite
+    size_t width = 0;
+    for (size_t i = 0; i < csr.rows; i++)
+        width = max(width, csr.row_ptr[i + 1] - csr.row_ptr[i]);
+    double ell_padding = double(width) * csr.rows / csr.nnz();
+    if (ell_padding <= 4.0) {
+        EllMatrix ell = csr_to_ell(csr);
+        ms = medir_ms(name + "/ell", [&] { spmv_ell(ell, xs.data(), ys.data()); });
+        print_row("ELL", ms, spmv_bytes(ell), ell_padding, max_diff());
+    } else {
+        cout << left << setw(12) << name << setw(16) << "ELL" << right
+             << setw(20) << "omitido" << setw(10) << ell_padding << "\n";
+    }
+
+    SellMatrix sell = csr_to_sell(csr, chunk, sigma);
+    ms = medir_ms(name + "/sell", [&] { spmv_sell(sell, xs.data(), ys.data()); });
+    print_row("SELL-" + to_string(chunk) + "-" + to_string(sigma), ms, spmv_bytes(sell),
+              double(sell.val.size()) / csr.nnz(), max_diff());
+}
+
+// GEMV con k vectores: k pasadas separadas contra un solo lote
+void benchmark_gemv_batched(ConstRealView A, int num_threads) {
+    const size_t m = A.rows(), n = A.cols();
+    const double a_bytes = double(m) * n * sizeof(real);
+
+    cout << "\nGEMV por lotes (A de " << m << "x" << n << ", " << num_threads << " hilos)\n";
+    cout << setw(4) << "k" << setw(14) << "Separado(ms)" << setw(9) << "GB/s"
+         << setw(11) << "Lote(ms)" << setw(9) << "GB/s" << setw(10) << "Speedup"
+         << setw(15) << "Lote hilos(ms)" << setw(10) << "Speedup" << setw(11) << "Error max" << "\n";
+    cout << string(93, '-') << "\n";
+
+    for (size_t k : {1, 4, 8, 16, 32}) {
+        Matrix<real> X(n, k), Y(m, k), Y_sep(m, k);
+        vector<real> xs(n), ys(m);
+        for (size_t j = 0; j < n; j++)
+            for (size_t r = 0; r < k; r++)
+                X(j, r) = 1.0 + 0.001 * double(r) - 0.0005 * double(j % 7);
+
+        // k pasadas: cada una lee A completa
+        const string prefix = "gemv_lotes/k=" + to_string(k) + "/";
+        double sep_ms = medir_ms(prefix + "separado", [&] {
+            for (size_t r = 0; r < k; r++) {
+                for (size_t j = 0; j < n; j++) xs[j] = X(j, r);
+                gemv(A, xs.data(), ys.data());
+                for (size_t i = 0; i < m; i++) Y_sep(i, r) = ys[i];
+            }
+        });
+        double batch_ms = medir_ms(prefix + "lote", [&] { gemv_batched(A, X, Y); });
+        double par_ms = medir_ms(prefix + "lote_hilos", [&] { gemv_batched_parallel(A, X, Y, num_threads); });
+
+        double err = 0.0;
+        for (size_t i = 0; i < m; i++)
+            for (size_t r = 0; r < k; r++)
+                err = max(err, fabs(Y(i, r) - Y_sep(i, r)));
+
+        double xy_bytes = double(n + m) * k * sizeof(real);
+        cout << setw(4) << k << setw(14) << sep_ms << setw(9) << gbps(k * a_bytes + xy_bytes, sep_ms)
+             << setw(11) << batch_ms << setw(9) << gbps(a_bytes + xy_bytes, batch_ms)
+             << setw(10) << sep_ms / batch_ms
+             << setw(15) << par_ms << setw(10) << sep_ms / par_ms
+             << setw(11) << scientific << setprecision(1) << err
+             << fixed << setprecision(2) << "\n";
+    }
+    cout << string(93, '-') << "\n";
+
+    // Camino de un solo vector repartido por filas
+    double single_ms = medir_ms("gemv", [&] { gemv(A, x, y); });
+    double par_ms = medir_ms("gemv_hilos", [&] { gemv_parallel(A, x, y, num_threads); });
+    cout << "GEMV de un vector: " << single_ms << " ms (" << gbps(DENSE_BYTES, single_ms)
+         << " GB/s), " << num_threads << " hilos: " << par_ms << " ms ("
+         << gbps(DENSE_BYTES, par_ms) << " GB/s)\n";
+    cout << "GB/s: bytes movidos (A se lee k veces por separado y una sola vez por lote)\n";
+}
+
 int main() {
+    Matrix<double> A(MAX, MAX);
+    Matrix<double, Layout::ColMajor> A_col(MAX, MAX);
+
     for (int i = 0; i < MAX; i++) {
         x[i] = 1.0;
         for (int j = 0; j < MAX; j++) {
-            A[i][j] = static_cast<double>(i + j) / MAX;
+            A(i, j) = static_cast<double>(i + j) / MAX;
+            A_col(i, j) = A(i, j);
+            A_old[i][j] = A(i, j);
         }
     }
 
-    /* -------- Primer par de bucles -------- */
-    for (int i = 0; i < MAX; i++)
-        y[i] = 0.0;
+    cout << fixed << setprecision(2);
 
-    auto start = high_resolution_clock::now();
-    for (int i = 0; i < MAX; i++) {
-        for (int j = 0; j < MAX; j++) {
-            y[i] += A[i][j] * x[j];
-        }
-    }
-    auto end = high_resolution_clock::now();
-    auto duration1 = duration_cast<milliseconds>(end - start).count();
+    /* -------- Primer par de bucles -------- */
+    auto duration1 = medir_ms("denso/filas", [&] { matvec_by_rows(A.view(), x, y); });
     cout << "Tiempo Primer par de bucles (row-major): "
-         << duration1 << " ms" << endl;
+         << duration1 << " ms (" << gbps(DENSE_BYTES, duration1) << " GB/s)" << endl;
 
     /* -------- Segundo par de bucles -------- */
-    for (int i = 0; i < MAX; i++)
-        y[i] = 0.0;
-
-    start = high_resolution_clock::now();
-    for (int j = 0; j < MAX; j++) {
-        for (int i = 0; i < MAX; i++) {
-            y[i] += A[i][j] * x[j];
-        }
-    }
-    end = high_resolution_clock::now();
-    auto duration2 = duration_cast<milliseconds>(end - start).count();
+    auto duration2 = medir_ms("denso/columnas", [&] { matvec_by_columns(A.view(), x, y); });
     cout << "Tiempo Segundo par de bucles (col-major): "
-         << duration2 << " ms" << endl;
+         << duration2 << " ms (" << gbps(DENSE_BYTES, duration2) << " GB/s)" << endl;
+
+    /* -------- Comparación de representaciones -------- */
+    ArregloGlobal A_global;
+    cout << "\n" << left << setw(28) << "Representacion"
+         << right << setw(14) << "Filas (ms)" << setw(16) << "Columnas (ms)" << "\n";
+    cout << string(58, '-') << "\n";
+    cout << left << setw(28) << "double[MAX][MAX] global" << right
+         << setw(14) << medir_ms("global/filas", [&] { matvec_by_rows(A_global, x, y); })
+         << setw(16) << medir_ms("global/columnas", [&] { matvec_by_columns(A_global, x, y); }) << "\n";
+    cout << left << setw(28) << "Matrix<double> row-major" << right
+         << setw(14) << medir_ms("row_major/filas", [&] { matvec_by_rows(A.view(), x, y); })
+         << setw(16) << medir_ms("row_major/columnas", [&] { matvec_by_columns(A.view(), x, y); }) << "\n";
+    cout << left << setw(28) << "Matrix<double> col-major" << right
+         << setw(14) << medir_ms("col_major/filas", [&] { matvec_by_rows(A_col.view(), x, y); })
+         << setw(16) << medir_ms("col_major/columnas", [&] { matvec_by_columns(A_col.view(), x, y); }) << "\n";
+
+    size_t num_threads = max(1u, thread::hardware_concurrency());
+
+    /* -------- GEMV por lotes (mismo A, k vectores) -------- */
+    benchmark_gemv_batched(A, int(num_threads));
+
+    /* -------- Matrices dispersas (~1% de no-ceros) -------- */
+    // N elegido para que el número de no-ceros sea del orden de MAX * MAX
+    const size_t N_SPARSE = 20000;
+    mt19937_64 rng(123456);
+
+    cout << "\nSpMV con N = " << N_SPARSE << " (~1% no-ceros); denso de referencia: "
+         << gbps(DENSE_BYTES, duration1) << " GB/s (filas), "
+         << gbps(DENSE_BYTES, duration2) << " GB/s (columnas)\n";
+    cout << left << setw(12) << "Matriz" << setw(16) << "Formato" << right
+         << setw(10) << "ms" << setw(10) << "GB/s" << setw(10) << "Relleno"
+         << setw(11) << "Error max" << "\n";
+    cout << string(69, '-') << "\n";
+    benchmark_spmv("banda", generate_banded(N_SPARSE, 100, rng), num_threads);
+    benchmark_spmv("potencia", generate_power_law(N_SPARSE, 200.0, 2.0, rng), num_threads);
+    cout << string(69, '-') << "\n";
+    cout << "Relleno: elementos guardados / no-ceros\n";
 
+    save_bench_report("1_bucles_anidados");
     return 0;
 }
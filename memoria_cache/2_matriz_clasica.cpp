@@ -1,12 +1,14 @@
 #include <iostream>
 #include <vector>
-#include <chrono>
 #include <cstdlib>
+#include <iomanip>
+
+#include "matriz.hpp"
+#include "../comun/benchmark.hpp"
 
 using namespace std;
-using namespace std::chrono;
 
-// Multiplicación clásica: C = A * B
+// Multiplicación clásica: C = A * B (representación anterior, vector de vectores)
 void matrixMultiply(const vector<vector<double>> &A,
                     const vector<vector<double>> &B,
                     vector<vector<double>> &C,
@@ -21,9 +23,47 @@ void matrixMultiply(const vector<vector<double>> &A,
     }
 }
 
+// Multiplicación clásica sobre arreglo aplanado con idx()
+void matrixMultiply(const vector<double> &A,
+                    const vector<double> &B,
+                    vector<double> &C,
+                    int N) {
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < N; j++) {
+            C[idx(i,j,N)] = 0.0;
+            for (int k = 0; k < N; k++) {
+                C[idx(i,j,N)] += A[idx(i,k,N)] * B[idx(k,j,N)];
+            }
+        }
+    }
+}
+
+// Multiplicación clásica sobre Matrix (contigua y alineada a 64 bytes)
+void matrixMultiply(ConstRealView A, ConstRealView B, RealView C) {
+    for (size_t i = 0; i < C.rows(); i++) {
+        for (size_t j = 0; j < C.cols(); j++) {
+            C(i,j) = 0.0;
+            for (size_t k = 0; k < A.cols(); k++) {
+                C(i,j) += A(i,k) * B(k,j);
+            }
+        }
+    }
+}
+
+// Mediana en ms medida con el harness compartido
+template <typename Kernel>
+double medir_ms(const string& name, Kernel kernel) {
+    return run_benchmark(name, kernel).median * 1e3;
+}
+
 int main() {
     int sizes[] = {100, 200, 400, 800, 1000};
 
+    cout << fixed << setprecision(2);
+    cout << setw(6) << "N" << setw(18) << "vector<vector>" << setw(14) << "vector+idx"
+         << setw(12) << "Matrix" << "   (ms)\n";
+    cout << string(57, '-') << "\n";
+
     for (int N : sizes) {
         vector<vector<double>> A(N, vector<double>(N));
         vector<vector<double>> B(N, vector<double>(N));
@@ -36,15 +76,26 @@ int main() {
             }
         }
 
+        // Mismos datos en las otras dos representaciones
+        vector<double> A_flat(N * N), B_flat(N * N), C_flat(N * N);
+        Matrix<double> A_m(N), B_m(N), C_m(N);
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                A_flat[idx(i,j,N)] = A_m(i,j) = A[i][j];
+                B_flat[idx(i,j,N)] = B_m(i,j) = B[i][j];
+            }
+        }
+
         //tiempo de multiplicación
-        auto start = high_resolution_clock::now();
-        matrixMultiply(A, B, C, N);
-        auto end = high_resolution_clock::now();
+        const string prefix = "N=" + to_string(N) + "/";
+        auto t_vv = medir_ms(prefix + "vector_vector", [&] { matrixMultiply(A, B, C, N); });
+        auto t_flat = medir_ms(prefix + "vector_idx", [&] { matrixMultiply(A_flat, B_flat, C_flat, N); });
+        auto t_m = medir_ms(prefix + "matrix", [&] { matrixMultiply(A_m, B_m, C_m); });
 
-        auto duration = duration_cast<milliseconds>(end - start).count();
-        cout << "N = " << N << " => Tiempo: "
-             << duration << " ms" << endl;
+        cout << setw(6) << N << setw(18) << t_vv << setw(14) << t_flat
+             << setw(12) << t_m << "\n";
     }
 
+    save_bench_report("2_matriz_clasica");
     return 0;
 }
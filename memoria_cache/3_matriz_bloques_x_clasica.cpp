@@ -1,88 +1,40 @@
-// g++ -O3 -march=native -std=c++20 3_matriz_bloques_x_clasica.cpp -o compare && ./compare
+// g++ -O3 -std=c++20 3_matriz_bloques_x_clasica.cpp -o compare && ./compare
 #include <iostream>
 #include <vector>
-#include <chrono>
 #include <random>
 #include <algorithm>
 #include <iomanip>
-#include <functional>
 #include <numeric>
+#include <map>
 
-using namespace std;
-using namespace std::chrono;
-using real = double;
-
-// Índice en arreglo aplanado row-major
-inline size_t idx(size_t i, size_t j, size_t N) { return i * N + j; }
-
-// Multiplicación clásica C = A * B (orden ijk)
-void matmul_classic(const vector<real>& A, const vector<real>& B,
-                   vector<real>& C, size_t N) {
-    for (size_t i = 0; i < N; ++i) {
-        for (size_t j = 0; j < N; ++j) {
-            real sum = 0.0;
-            for (size_t k = 0; k < N; ++k) {
-                sum += A[idx(i,k,N)] * B[idx(k,j,N)];
-            }
-            C[idx(i,j,N)] = sum;
-        }
-    }
-}
+#include "gemm_empaquetado.hpp"
+#include "arena.hpp"
+#include "autotuner.hpp"
+#include "../comun/benchmark.hpp"
 
-// Multiplicación por bloques optimizada
-void matmul_blocked(const vector<real>& A, const vector<real>& B,
-                   vector<real>& C, size_t N, size_t block_size) {
-    fill(C.begin(), C.end(), 0.0);
-
-    for (size_t ii = 0; ii < N; ii += block_size) {
-        for (size_t jj = 0; jj < N; jj += block_size) {
-            for (size_t kk = 0; kk < N; kk += block_size) {
-                // Límites del bloque
-                size_t i_end = min(ii + block_size, N);
-                size_t j_end = min(jj + block_size, N);
-                size_t k_end = min(kk + block_size, N);
-
-                // Multiplicación del bloque
-                for (size_t i = ii; i < i_end; ++i) {
-                    for (size_t j = jj; j < j_end; ++j) {
-                        real sum = C[idx(i,j,N)];
-                        for (size_t k = kk; k < k_end; ++k) {
-                            sum += A[idx(i,k,N)] * B[idx(k,j,N)];
-                        }
-                        C[idx(i,j,N)] = sum;
-                    }
-                }
-            }
-        }
-    }
-}
+using namespace std;
 
 // Estructura para almacenar resultados de benchmark
 struct BenchResult {
     string method;
-    size_t block_size;
-    double avg_time;
+    string block;
+    BenchStats stats;
     double speedup;
 };
 
-// Función para medir tiempo de ejecución
-double benchmark_algorithm(function<void()> algo, int repeats = 3) {
-    double total_time = 0.0;
-    for (int i = 0; i < repeats; ++i) {
-        auto start = high_resolution_clock::now();
-        algo();
-        auto end = high_resolution_clock::now();
-        total_time += duration_cast<duration<double>>(end - start).count();
-    }
-    return total_time / repeats;
+// GFLOP/s de una multiplicación N x N (2*N^3 operaciones)
+double gflops(size_t N, double seconds) {
+    return 2.0 * N * N * N / seconds * 1e-9;
 }
 
 // Inicializar matrices con valores aleatorios
-void init_matrices(vector<real>& A, vector<real>& B, size_t N, mt19937_64& rng) {
+void init_matrices(RealView A, RealView B, mt19937_64& rng) {
     uniform_real_distribution<real> dist(0.0, 1.0);
-    for (size_t i = 0; i < N * N; ++i) {
-        A[i] = dist(rng);
-        B[i] = dist(rng);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
     }
 }
 
@@ -92,54 +44,81 @@ int main() {
 
     const vector<size_t> sizes = {256, 512, 768}; //1024
     const vector<size_t> block_sizes = {16, 32, 64}; //128
-    const int repeats = 3;
+
+    // Tiles autotuneados: se buscan solo si no están en la caché de tuning
+    map<size_t, BlockShape> tuned;
+    for (size_t N : sizes) tuned[N] = tuned_block_shape(N);
 
     mt19937_64 rng(123456);
 
+    // A, B y C de todos los tamaños salen de la misma región con páginas
+    // grandes: no se vuelve a pedir memoria ni a ponerla en cero en cada N
+    MatrixArena arena;
+    const size_t max_n = *max_element(sizes.begin(), sizes.end());
+    arena.reserve(3 * max_n * max_n * sizeof(real));
+
     cout << fixed << setprecision(3);
     cout << "=== ANÁLISIS DE RENDIMIENTO: MULTIPLICACION CLASICA vs BLOQUES ===\n\n";
-    cout << setw(6) << "N" << setw(12) << "Metodo" << setw(8) << "Bloque"
-         << setw(10) << "Tiempo(s)" << setw(10) << "Speedup" << "\n";
-    cout << string(50, '-') << "\n";
+    cout << setw(6) << "N" << setw(12) << "Metodo" << setw(12) << "Bloque"
+         << setw(11) << "Mediana(s)" << setw(8) << "IC95%" << setw(10) << "Speedup"
+         << setw(10) << "GFLOP/s" << "\n";
+    cout << string(69, '-') << "\n";
 
     for (size_t N : sizes) {
-        vector<real> A(N*N), B(N*N), C(N*N);
+        arena.reset();
+        RealView A = arena.matrix(N, N), B = arena.matrix(N, N), C = arena.matrix(N, N);
         vector<BenchResult> results;
 
-        init_matrices(A, B, N, rng);
+        init_matrices(A, B, rng);
+
+        const string prefix = "N=" + to_string(N) + "/";
 
-        // Benchmark clásico
-        double classic_time = benchmark_algorithm([&]() {
-            fill(C.begin(), C.end(), 0.0);
-            matmul_classic(A, B, C, N);
-        }, repeats);
+        // Benchmark clásico (C = 0 fuera de la medición)
+        BenchStats classic = run_benchmark_setup(prefix + "clasico", [&]() { C.fill(0.0); }, [&]() {
+            matmul_classic(A, B, C);
+        });
+        double classic_time = classic.median;
 
-        results.push_back({"Clasico", 0, classic_time, 1.0});
+        results.push_back({"Clasico", "-", classic, 1.0});
 
         // Benchmark bloques
         for (size_t block_size : block_sizes) {
             if (block_size > N) continue;
 
-            double blocked_time = benchmark_algorithm([&]() {
-                matmul_blocked(A, B, C, N, block_size);
-            }, repeats);
+            BenchStats blocked = run_benchmark(prefix + "bloques/" + to_string(block_size), [&]() {
+                matmul_blocked(A, B, C, block_size);
+            });
 
-            double speedup = classic_time / blocked_time;
-            results.push_back({"Bloques", block_size, blocked_time, speedup});
+            double speedup = classic_time / blocked.median;
+            results.push_back({"Bloques", to_string(block_size), blocked, speedup});
         }
 
+        // Benchmark bloques con el tile autotuneado para este N
+        BenchStats tuned_stats = run_benchmark(prefix + "autotuneado/" + shape_label(tuned[N]), [&]() {
+            matmul_blocked(A, B, C, tuned[N]);
+        });
+
+        results.push_back({"Autotuneado", shape_label(tuned[N]), tuned_stats, classic_time / tuned_stats.median});
+
+        // Benchmark empaquetado (micro-kernel MR x NR)
+        BenchStats packed = run_benchmark(prefix + "empaquetado", [&]() {
+            matmul_packed(A, B, C);
+        });
+
+        results.push_back({"Empaquetado", "-", packed, classic_time / packed.median});
+
         // Mostrar resultados
         for (const auto& result : results) {
-            cout << setw(6) << N << setw(12) << result.method;
-            if (result.block_size > 0) {
-                cout << setw(8) << result.block_size;
-            } else {
-                cout << setw(8) << "-";
-            }
-            cout << setw(10) << result.avg_time << setw(10) << result.speedup << "\n";
+            cout << setw(6) << N << setw(12) << result.method << setw(12) << result.block;
+            cout << setw(11) << result.stats.median
+                 << setw(7) << setprecision(1) << result.stats.ci95 * 100 << "%" << setprecision(3)
+                 << setw(10) << result.speedup
+                 << setw(10) << gflops(N, result.stats.median) << "\n";
         }
-        cout << string(50, '-') << "\n";
+        cout << string(69, '-') << "\n";
     }
+    cout << "Mediana de las repeticiones; IC95%: semiancho del intervalo de confianza de la media\n";
 
+    save_bench_report("3_matriz_bloques_x_clasica");
     return 0;
 }
\ No newline at end of file
@@ -17,96 +17,54 @@
 
 #include <iostream>
 #include <vector>
-#include <chrono>
 #include <random>
 #include <algorithm>
 #include <iomanip>
 #include <numeric>
 #include <fstream>
+#include <sstream>
+#include <map>
 
-using namespace std;
-using namespace std::chrono;
-using real = double;
-
-// Índice en arreglo aplanado row-major
-inline size_t idx(size_t i, size_t j, size_t N) { return i * N + j; }
-
-// Multiplicación clásica C = A * B (orden ijk)
-void matmul_classic(const vector<real>& A, const vector<real>& B,
-                   vector<real>& C, size_t N) {
-    for (size_t i = 0; i < N; ++i) {
-        for (size_t j = 0; j < N; ++j) {
-            real sum = 0.0;
-            for (size_t k = 0; k < N; ++k) {
-                sum += A[idx(i,k,N)] * B[idx(k,j,N)];
-            }
-            C[idx(i,j,N)] = sum;
-        }
-    }
-}
+#include "autotuner.hpp"
+#include "../comun/benchmark.hpp"
+#include "../comun/perf_counters.hpp"
 
-// Multiplicación por bloques optimizada
-void matmul_blocked(const vector<real>& A, const vector<real>& B,
-                   vector<real>& C, size_t N, size_t block_size) {
-    fill(C.begin(), C.end(), 0.0);
-
-    for (size_t ii = 0; ii < N; ii += block_size) {
-        for (size_t jj = 0; jj < N; jj += block_size) {
-            for (size_t kk = 0; kk < N; kk += block_size) {
-                // Límites del bloque
-                size_t i_end = min(ii + block_size, N);
-                size_t j_end = min(jj + block_size, N);
-                size_t k_end = min(kk + block_size, N);
-
-                // Multiplicación del bloque
-                for (size_t i = ii; i < i_end; ++i) {
-                    for (size_t j = jj; j < j_end; ++j) {
-                        real sum = C[idx(i,j,N)];
-                        for (size_t k = kk; k < k_end; ++k) {
-                            sum += A[idx(i,k,N)] * B[idx(k,j,N)];
-                        }
-                        C[idx(i,j,N)] = sum;
-                    }
-                }
-            }
-        }
-    }
-}
+using namespace std;
 
 // Estructura para almacenar resultados de benchmark
 struct BenchResult {
     string method;
-    size_t block_size;
-    double avg_time;
+    string block;
+    double time;
     double speedup;
+    PerfSample counters;
 };
 
-// Función para medir tiempo de ejecución
-double benchmark_algorithm(function<void()> algo, int repeats = 3) {
-    double total_time = 0.0;
-    for (int i = 0; i < repeats; ++i) {
-        auto start = high_resolution_clock::now();
-        algo();
-        auto end = high_resolution_clock::now();
-        total_time += duration_cast<duration<double>>(end - start).count();
-    }
-    return total_time / repeats;
-}
-
 // Inicializar matrices con valores aleatorios
-void init_matrices(vector<real>& A, vector<real>& B, size_t N, mt19937_64& rng) {
+void init_matrices(Matrix<real>& A, Matrix<real>& B, mt19937_64& rng) {
     uniform_real_distribution<real> dist(0.0, 1.0);
-    for (size_t i = 0; i < N * N; ++i) {
-        A[i] = dist(rng);
-        B[i] = dist(rng);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
     }
 }
 
-// Función para generar reporte detallado de profiling
-void generate_profiling_report(const string& algorithm, size_t N, size_t block_size = 0) {
+// Métrica derivada como texto ("n/d" si faltan contadores)
+string format_metric(double value, double scale = 1.0, int precision = 2) {
+    if (value < 0) return "n/d";
+    ostringstream out;
+    out << fixed << setprecision(precision) << value * scale;
+    return out.str();
+}
+
+// Reporte de profiling con los contadores de hardware de una ejecución del kernel
+void generate_profiling_report(const string& algorithm, size_t N, const PerfCounters& perf,
+                               const PerfSample& sample, double time, const string& block = "") {
     string filename = "profile_report_" + algorithm + "_N" + to_string(N);
-    if (block_size > 0) {
-        filename += "_B" + to_string(block_size);
+    if (!block.empty()) {
+        filename += "_B" + block;
     }
     filename += ".txt";
 
@@ -114,14 +72,33 @@ void generate_profiling_report(const string& algorithm, size_t N, size_t block_s
     report << "=== REPORTE DE PROFILING ===" << endl;
     report << "Algoritmo: " << algorithm << endl;
     report << "Tamaño matriz: " << N << "x" << N << endl;
-    if (block_size > 0) {
-        report << "Tamaño bloque: " << block_size << endl;
+    if (!block.empty()) {
+        report << "Tamaño bloque: " << block << endl;
     }
     report << "Fecha: " << __DATE__ << " " << __TIME__ << endl;
+    report << "Tiempo (mediana): " << fixed << setprecision(6) << time << " s" << endl;
+    report << endl;
+
+    report << "--- Contadores (perf_event_open, modo usuario) ---" << endl;
+    for (int e = 0; e < PERF_NUM_EVENTS; ++e) {
+        report << left << setw(24) << perf_event_name(e) << right;
+        if (sample.has(e)) report << setw(18) << setprecision(0) << sample.value[e] << endl;
+        else report << setw(18) << "n/d" << endl;
+    }
     report << endl;
-    report << "Para obtener métricas detalladas ejecutar:" << endl;
-    report << "valgrind --tool=cachegrind --cache-sim=yes ./" << endl;
-    report << "kcachegrind cachegrind.out.*" << endl;
+    report << "--- Métricas derivadas ---" << endl;
+    report << "IPC:                     " << format_metric(sample.ipc()) << endl;
+    report << "Tasa de fallos L1D (%):  " << format_metric(sample.l1d_miss_rate(), 100.0) << endl;
+    report << "Tasa de fallos LLC (%):  " << format_metric(sample.llc_miss_rate(), 100.0) << endl;
+    report << "Fallos dTLB por 1000 ins: " << format_metric(sample.dtlb_mpki()) << endl;
+    report << "Saltos mal predichos (%): " << format_metric(sample.branch_miss_rate(), 100.0) << endl;
+
+    if (!perf.available()) {
+        report << endl;
+        report << "Contadores de hardware no disponibles (" << perf.error() << ")." << endl;
+        report << "Revisar /proc/sys/kernel/perf_event_paranoid (<= 2) o, como alternativa," << endl;
+        report << "simular la caché con: valgrind --tool=cachegrind --cache-sim=yes ./analisis" << endl;
+    }
     report.close();
 
     cout << "Reporte generado: " << filename << endl;
@@ -133,65 +110,80 @@ int main() {
 
     // Tamaños reducidos para profiling detallado
     const vector<size_t> sizes = {256, 512};
-    const vector<size_t> block_sizes = {16, 32, 64};
-    const int repeats = 1; // Reducido para profiling
+    // Una sola corrida sin calentamiento: bajo valgrind cada ejecución es costosa
+    const BenchConfig config = single_run_config();
+
+    // Tile autotuneado por N: se reutiliza la caché de tuning si existe
+    map<size_t, BlockShape> tuned;
+    for (size_t N : sizes) tuned[N] = tuned_block_shape(N);
 
     mt19937_64 rng(123456);
 
-    cout << "=== ANÁLISIS CON VALGRIND/KCACHEGRIND ===\n";
-    cout << "Ejecutar con: valgrind --tool=callgrind --cache-sim=yes ./matrix_mult\n\n";
+    PerfCounters perf;
+
+    cout << "=== ANÁLISIS CON CONTADORES DE HARDWARE ===\n";
+    if (perf.available()) {
+        cout << "Contadores: perf_event_open (ciclos, instrucciones, L1D, LLC, dTLB, saltos)\n\n";
+    } else {
+        cout << "Contadores de hardware no disponibles (" << perf.error() << ")\n"
+             << "Se reportan solo tiempos; alternativa: valgrind --tool=cachegrind --cache-sim=yes ./analisis\n\n";
+    }
     cout << fixed << setprecision(3);
-    cout << setw(6) << "N" << setw(12) << "Método" << setw(8) << "Bloque"
-         << setw(10) << "Tiempo(s)" << setw(15) << "Profiling" << "\n";
-    cout << string(55, '-') << "\n";
+    cout << setw(6) << "N" << setw(12) << "Método" << setw(12) << "Bloque"
+         << setw(10) << "Tiempo(s)" << setw(7) << "IPC" << setw(9) << "L1D %"
+         << setw(9) << "LLC %" << setw(11) << "dTLB MPKI" << setw(10) << "Saltos %" << "\n";
+    cout << string(86, '-') << "\n";
 
     for (size_t N : sizes) {
-        vector<real> A(N*N), B(N*N), C(N*N);
+        Matrix<real> A(N), B(N), C(N);
         vector<BenchResult> results;
 
-        init_matrices(A, B, N, rng);
+        init_matrices(A, B, rng);
 
         cout << "Ejecutando profiling para N=" << N << "..." << endl;
 
-        // Profiling clásico
-        double classic_time = benchmark_algorithm([&]() {
-            fill(C.begin(), C.end(), 0.0);
-            matmul_classic(A, B, C, N);
-        }, repeats);
+        // Profiling clásico: tiempo y, en otra ejecución, contadores
+        auto classic = [&]() { matmul_classic(A, B, C); };
+        double classic_time = run_benchmark_setup("N=" + to_string(N) + "/clasico",
+                                                  [&]() { C.fill(0.0); }, classic, config).median;
+        C.fill(0.0);
+        PerfSample classic_counters = measure_counters(perf, classic);
 
-        generate_profiling_report("clasico", N);
-        results.push_back({"Clásico", 0, classic_time, 1.0});
+        generate_profiling_report("clasico", N, perf, classic_counters, classic_time);
+        results.push_back({"Clásico", "-", classic_time, 1.0, classic_counters});
 
-        // Profiling bloques - solo el mejor tamaño (16)
-        size_t best_block = 16;
+        // Profiling bloques - solo el mejor tile (autotuneado)
+        BlockShape best_block = tuned[N];
+        auto blocked = [&]() { matmul_blocked(A, B, C, best_block); };
 
-        double blocked_time = benchmark_algorithm([&]() {
-            matmul_blocked(A, B, C, N, best_block);
-        }, repeats);
+        double blocked_time = run_benchmark("N=" + to_string(N) + "/bloques/" + shape_label(best_block),
+                                            blocked, config).median;
+        PerfSample blocked_counters = measure_counters(perf, blocked);
 
         double speedup = classic_time / blocked_time;
-        generate_profiling_report("bloques", N, best_block);
-        results.push_back({"Bloques", best_block, blocked_time, speedup});
+        generate_profiling_report("bloques", N, perf, blocked_counters, blocked_time, shape_label(best_block));
+        results.push_back({"Bloques", shape_label(best_block), blocked_time, speedup, blocked_counters});
 
         // Mostrar resultados
         for (const auto& result : results) {
-            cout << setw(6) << N << setw(12) << result.method;
-            if (result.block_size > 0) {
-                cout << setw(8) << result.block_size;
-            } else {
-                cout << setw(8) << "-";
-            }
-            cout << setw(10) << result.avg_time << setw(15) << "✓" << "\n";
+            const PerfSample& pc = result.counters;
+            cout << setw(6) << N << setw(12) << result.method << setw(12) << result.block;
+            cout << setw(10) << result.time << setw(7) << format_metric(pc.ipc())
+                 << setw(9) << format_metric(pc.l1d_miss_rate(), 100.0)
+                 << setw(9) << format_metric(pc.llc_miss_rate(), 100.0)
+                 << setw(11) << format_metric(pc.dtlb_mpki())
+                 << setw(10) << format_metric(pc.branch_miss_rate(), 100.0) << "\n";
         }
-        cout << string(55, '-') << "\n";
+        cout << string(86, '-') << "\n";
     }
 
-    cout << "\n=== INSTRUCCIONES DE ANÁLISIS ===\n";
+    cout << "\n=== ANÁLISIS COMPLEMENTARIO (SIMULACIÓN DE CACHÉ) ===\n";
     cout << "1. Ejecutar: valgrind --tool=cachegrind ./analisis > cache_report.txt\n";
     cout << "2. Visualizar: kcachegrind cachegrind.out.*\n";
     cout << "3. Para callgrind: valgrind --tool=callgrind ./analisis\n";
     cout << "4. Visualizar: kcachegrind callgrind.out.*\n";
     cout << "\nArchivos de reporte generados en el directorio actual.\n";
 
+    save_bench_report("4_analisis");
     return 0;
 }
\ No newline at end of file
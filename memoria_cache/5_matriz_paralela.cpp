@@ -0,0 +1,167 @@
+// g++ -O3 -std=c++20 -pthread 5_matriz_paralela.cpp -o paralela && ./paralela [max_hilos] [N_debil]
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <thread>
+#include <string>
+
+#include "gemm_paralelo.hpp"
+#include "arena.hpp"
+#include "../comun/benchmark.hpp"
+#include "../comun/scaling.hpp"
+
+using namespace std;
+
+// Inicializar matrices con valores aleatorios
+void init_matrices(RealView A, RealView B, mt19937_64& rng) {
+    uniform_real_distribution<real> dist(0.0, 1.0);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    int max_threads = static_cast<int>(thread::hardware_concurrency());
+    if (argc > 1) max_threads = stoi(argv[1]);
+    max_threads = max(1, max_threads);
+    // Escalado débil: N0 con 1 hilo y N0 * p^(1/3) con p (trabajo 2N³ proporcional a p)
+    const size_t weak_base = argc > 2 ? stoul(argv[2]) : 512;
+
+    const vector<size_t> sizes = {256, 512, 1024, 2048, 4096};
+
+    mt19937_64 rng(123456);
+    vector<ScalingSeries> series;
+
+    // Con N = 4096 cada matriz son 128 MB (32768 páginas de 4 KB): la arena
+    // las pone en páginas grandes y reutiliza la región en cada tamaño
+    MatrixArena arena;
+    const size_t max_n = max(sizes.back(), static_cast<size_t>(llround(weak_base * cbrt(double(max_threads)))));
+    arena.reserve(4 * max_n * max_n * sizeof(real));
+
+    cout << fixed << setprecision(3);
+    cout << "=== GEMM MULTIHILO: TILES 2D DE C (max " << max_threads << " hilos) ===\n\n";
+    cout << setw(6) << "N" << setw(7) << "Hilos" << setw(8) << "Rejilla"
+         << setw(11) << "Tiempo(s)" << setw(10) << "GFLOP/s" << setw(10) << "Speedup"
+         << setw(12) << "Eficiencia" << setw(12) << "Error max" << "\n";
+    cout << string(76, '-') << "\n";
+
+    for (size_t N : sizes) {
+        arena.reset();
+        RealView A = arena.matrix(N, N), B = arena.matrix(N, N), C = arena.matrix(N, N);
+        RealView C_ref = arena.matrix(N, N);
+        init_matrices(A, B, rng);
+
+        double base_time = 0.0;
+        ScalingSeries strong{"N=" + to_string(N), ScalingMode::Strong, {}};
+
+        for (int threads : scaling_thread_counts(max_threads)) {
+            double time = run_benchmark("N=" + to_string(N) + "/hilos=" + to_string(threads), [&]() {
+                matmul_parallel(A, B, C, threads);
+            }).median;
+
+            // Referencia: la ejecución con 1 hilo
+            if (threads == 1) {
+                base_time = time;
+                copy(C.data(), C.data() + N * N, C_ref.data());
+            }
+            double max_err = 0.0;
+            for (size_t i = 0; i < N; ++i) {
+                for (size_t j = 0; j < N; ++j) {
+                    max_err = max(max_err, fabs(C(i,j) - C_ref(i,j)));
+                }
+            }
+
+            int rows, cols;
+            thread_grid(threads, rows, cols);
+            double speedup = base_time / time;
+            strong.points.push_back({threads, 2.0 * N * N * N, time});
+
+            cout << setw(6) << N << setw(7) << threads
+                 << setw(8) << (to_string(rows) + "x" + to_string(cols))
+                 << setw(11) << time
+                 << setw(10) << 2.0 * N * N * N / time * 1e-9
+                 << setw(10) << speedup
+                 << setw(11) << speedup / threads * 100 << "%"
+                 << setw(12) << scientific << setprecision(1) << max_err
+                 << fixed << setprecision(3) << "\n";
+        }
+        double f = fit_serial_fraction(strong);
+        if (f >= 0.0) cout << "Amdahl: fracción serial " << setprecision(4) << f << setprecision(3) << "\n";
+        cout << string(76, '-') << "\n";
+        series.push_back(strong);
+    }
+
+    // Escalado débil: el tamaño crece con los hilos para que cada uno tenga
+    // el mismo trabajo
+    ScalingSeries weak{"N0=" + to_string(weak_base), ScalingMode::Weak, {}};
+    for (int threads : scaling_thread_counts(max_threads)) {
+        size_t N = static_cast<size_t>(llround(weak_base * cbrt(double(threads))));
+        arena.reset();
+        RealView A = arena.matrix(N, N), B = arena.matrix(N, N), C = arena.matrix(N, N);
+        init_matrices(A, B, rng);
+        double time = run_benchmark("debil/N=" + to_string(N) + "/hilos=" + to_string(threads), [&]() {
+            matmul_parallel(A, B, C, threads);
+        }).median;
+        weak.points.push_back({threads, 2.0 * N * N * N, time});
+    }
+    series.push_back(weak);
+
+    cout << "\n=== ESCALADO DÉBIL: N = " << weak_base << " * p^(1/3) ===\n";
+    print_scaling_table({weak});
+    write_scaling_csv(series, "escalado_gemm.csv");
+
+    // Desbalance: un hilo que gira fijo en la CPU 0 le quita tiempo a uno de
+    // los hilos de la GEMM. Con la rejilla estática todos esperan a ese hilo;
+    // con robo de trabajo los demás se llevan sus tiles pendientes
+    const size_t N = 2048;
+    arena.reset();
+    RealView A = arena.matrix(N, N), B = arena.matrix(N, N), C = arena.matrix(N, N);
+    RealView C_ref = arena.matrix(N, N);
+    init_matrices(A, B, rng);
+    matmul_parallel(A, B, C_ref, 1);
+
+    cout << "\n=== DESBALANCE: REJILLA ESTÁTICA vs ROBO DE TRABAJO (N = " << N << ", "
+         << max_threads << " hilos) ===\n\n";
+    cout << left << setw(10) << "Carga" << setw(18) << "Reparto" << right << setw(11) << "Tiempo(s)"
+         << setw(10) << "GFLOP/s" << setw(9) << "vs sin" << setw(8) << "Robos" << setw(12) << "Error max" << "\n";
+    cout << string(78, '-') << "\n";
+
+    double unloaded[2] = {};
+    for (bool loaded : {false, true}) {
+        unique_ptr<BusySpinner> spinner;
+        if (loaded) spinner = make_unique<BusySpinner>(0);
+        const string load = loaded ? "spinner" : "ninguna";
+
+        for (int stealing = 0; stealing < 2; ++stealing) {
+            const string name = stealing ? "robo de trabajo" : "rejilla fija";
+            double time = run_benchmark("desbalance/" + load + "/" + (stealing ? "robo" : "estatico"), [&]() {
+                if (stealing) matmul_work_stealing(A, B, C, max_threads);
+                else matmul_parallel(A, B, C, max_threads);
+            }).median;
+            if (!loaded) unloaded[stealing] = time;
+
+            double max_err = 0.0;
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = 0; j < N; ++j)
+                    max_err = max(max_err, fabs(C(i,j) - C_ref(i,j)));
+
+            cout << fixed << setprecision(3) << left << setw(10) << load << setw(18) << name
+                 << right << setw(11) << time << setw(10) << 2.0 * N * N * N / time * 1e-9
+                 << setw(8) << time / unloaded[stealing] << "x"
+                 << setw(8) << (stealing ? to_string(default_stealer().last_stats().steals) : "-")
+                 << setw(12) << scientific << setprecision(1) << max_err << fixed << setprecision(3) << "\n";
+        }
+    }
+
+    save_bench_report("5_matriz_paralela");
+    return 0;
+}
@@ -0,0 +1,114 @@
+// g++ -O3 -std=c++20 -pthread 6_bloques_multinivel.cpp -o multinivel && ./multinivel [max_N]
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <string>
+
+#include "bloques_multinivel.hpp"
+#include "../comun/benchmark.hpp"
+
+using namespace std;
+
+// Inicializar matrices con valores aleatorios
+void init_matrices(Matrix<real>& A, Matrix<real>& B, mt19937_64& rng) {
+    uniform_real_distribution<real> dist(0.0, 1.0);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+}
+
+// Mayor N cuyo conjunto de trabajo (A, B y C: 3 * N^2 reales) cabe en `bytes`
+size_t n_for_bytes(size_t bytes) {
+    return static_cast<size_t>(sqrt(bytes / (3.0 * sizeof(real))));
+}
+
+size_t round_to_64(double n) {
+    return max<size_t>(64, static_cast<size_t>(n / 64.0 + 0.5) * 64);
+}
+
+// Nivel de la jerarquía donde cabe el conjunto de trabajo de N
+string working_set_level(size_t N, const CpuInfo& cpu) {
+    size_t bytes = 3 * N * N * sizeof(real);
+    if (bytes <= cpu.l1d.size) return "L1";
+    if (bytes <= cpu.l2.size) return "L2";
+    if (bytes <= cpu.l3.size) return "L3";
+    return "DRAM";
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t max_n = 4096;
+    if (argc > 1) max_n = stoul(argv[1]);
+
+    const CpuInfo& cpu = detect_cpu_info();
+    const MultiLevelTiling tiling = tiling_from_caches(cpu);
+
+    cout << "=== BLOCKING MULTINIVEL SEGUN LA JERARQUIA DE CACHE ===\n\n";
+    cout << "CPU: " << cpu.model << "\n";
+    const CacheLevel* levels[3] = {&cpu.l1d, &cpu.l2, &cpu.l3};
+    const char* names[3] = {"L1d", "L2", "L3"};
+    for (int l = 0; l < 3; ++l) {
+        const BlockShape& s = tiling.levels[l];
+        cout << "  " << setw(4) << left << names[l] << right
+             << setw(10) << levels[l]->size / 1024 << " KB"
+             << "  linea " << levels[l]->line_size << " B"
+             << "  -> tile " << shape_label(s)
+             << " (" << 3 * s.bi * s.bj * sizeof(real) / 1024 << " KB)\n";
+    }
+
+    // Tamaños alrededor de los puntos donde A+B+C deja de caber en L2 y en L3
+    const size_t n_l2 = n_for_bytes(cpu.l2.size);
+    const size_t n_l3 = n_for_bytes(cpu.l3.size);
+    vector<size_t> sizes = {round_to_64(n_l2 * 0.75), round_to_64(n_l2 * 2.0),
+                            round_to_64(n_l3 * 0.75), round_to_64(n_l3 * 1.25)};
+    sort(sizes.begin(), sizes.end());
+    sizes.erase(unique(sizes.begin(), sizes.end()), sizes.end());
+
+    cout << "\nA+B+C desborda L2 en N > " << n_l2 << " y L3 en N > " << n_l3 << "\n";
+    if (sizes.back() > max_n) {
+        cout << "(se omiten N > " << max_n << "; pasar max_N como argumento para incluirlos)\n";
+        sizes.erase(remove_if(sizes.begin(), sizes.end(),
+                              [&](size_t n) { return n > max_n; }), sizes.end());
+    }
+
+    mt19937_64 rng(123456);
+    const BlockShape l1_tile = tiling.levels[0];
+
+    cout << fixed << setprecision(3) << "\n";
+    cout << setw(6) << "N" << setw(12) << "Datos(MB)" << setw(7) << "Cabe"
+         << setw(14) << "Bloques L1(s)" << setw(15) << "Multinivel(s)" << setw(10) << "Ganancia" << "\n";
+    cout << string(64, '-') << "\n";
+
+    for (size_t N : sizes) {
+        Matrix<real> A(N), B(N), C(N);
+        init_matrices(A, B, rng);
+
+        // Referencia: un solo nivel con el tile de L1
+        double single_time = run_benchmark("N=" + to_string(N) + "/bloques_l1", [&]() {
+            matmul_blocked(A, B, C, l1_tile);
+        }).median;
+
+        double multi_time = run_benchmark("N=" + to_string(N) + "/multinivel", [&]() {
+            matmul_blocked_multilevel(A, B, C, tiling);
+        }).median;
+
+        cout << setw(6) << N
+             << setw(12) << 3.0 * N * N * sizeof(real) / (1024.0 * 1024.0)
+             << setw(7) << working_set_level(N, cpu)
+             << setw(14) << single_time
+             << setw(15) << multi_time
+             << setw(9) << single_time / multi_time << "x\n";
+    }
+    cout << string(64, '-') << "\n";
+
+    save_bench_report("6_bloques_multinivel");
+    return 0;
+}
@@ -0,0 +1,111 @@
+// g++ -O3 -std=c++20 -pthread 7_strassen.cpp -o strassen && ./strassen [max_N]
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+
+#include "gemm_bloques.hpp"
+#include "strassen.hpp"
+#include "../comun/benchmark.hpp"
+
+using namespace std;
+
+// Inicializar matrices con valores aleatorios
+void init_matrices(Matrix<real>& A, Matrix<real>& B, mt19937_64& rng) {
+    uniform_real_distribution<real> dist(0.0, 1.0);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+}
+
+double max_error(const Matrix<real>& C, const Matrix<real>& ref) {
+    double err = 0.0;
+    for (size_t i = 0; i < C.rows(); ++i)
+        for (size_t j = 0; j < C.cols(); ++j)
+            err = max(err, fabs(C(i,j) - ref(i,j)));
+    return err;
+}
+
+int main(int argc, char* argv[]) {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    size_t max_n = 2048;
+    if (argc > 1) max_n = stoul(argv[1]);
+
+    // Incluye tamaños impares para ejercitar el peeling
+    vector<size_t> sizes = {512, 1000, 1024, 2047, 2048, 4096};
+    sizes.erase(remove_if(sizes.begin(), sizes.end(),
+                          [&](size_t n) { return n > max_n; }), sizes.end());
+    const vector<size_t> cutoffs = {64, 128, 256, 512};
+
+    mt19937_64 rng(123456);
+
+    cout << fixed << setprecision(3);
+    cout << "=== STRASSEN-WINOGRAD vs CLASICO vs EMPAQUETADO ===\n";
+    cout << "(error maximo absoluto contra matmul_classic)\n\n";
+    cout << setw(6) << "N" << setw(13) << "Metodo" << setw(8) << "Cutoff"
+         << setw(11) << "Tiempo(s)" << setw(15) << "vs Empaquetado" << setw(12) << "Error max" << "\n";
+    cout << string(65, '-') << "\n";
+
+    for (size_t N : sizes) {
+        Matrix<real> A(N), B(N), C(N), C_ref(N);
+        init_matrices(A, B, rng);
+
+        auto print_row = [&](const string& method, const string& cutoff,
+                             double time, double packed_time, double err) {
+            cout << setw(6) << N << setw(13) << method << setw(8) << cutoff
+                 << setw(11) << time << setw(14) << packed_time / time << "x"
+                 << setw(12) << scientific << setprecision(2) << err
+                 << fixed << setprecision(3) << "\n";
+        };
+
+        // Referencia: una sola ejecución, solo para medir el error
+        const string prefix = "N=" + to_string(N) + "/";
+        double classic_time = run_benchmark(prefix + "clasico", [&]() {
+            matmul_classic(A, B, C_ref);
+        }, single_run_config()).median;
+
+        double packed_time = run_benchmark(prefix + "empaquetado", [&]() {
+            matmul_packed(A, B, C);
+        }).median;
+        double packed_err = max_error(C, C_ref);
+
+        print_row("Clasico", "-", classic_time, packed_time, 0.0);
+        print_row("Empaquetado", "-", packed_time, packed_time, packed_err);
+
+        double best_time = packed_time;
+        size_t best_cutoff = 0;
+        for (size_t cutoff : cutoffs) {
+            if (cutoff >= N) continue;
+
+            // Workspace reservado fuera de la medición: la recursión no reserva
+            StrassenWorkspace ws = make_strassen_workspace(N, N, N, cutoff);
+            double time = run_benchmark(prefix + "strassen/" + to_string(cutoff), [&]() {
+                matmul_strassen(A, B, C, ws);
+            }).median;
+
+            print_row("Strassen", to_string(cutoff), time, packed_time, max_error(C, C_ref));
+            if (time < best_time) {
+                best_time = time;
+                best_cutoff = cutoff;
+            }
+        }
+
+        if (best_cutoff > 0) {
+            cout << "  -> Strassen gana con cutoff " << best_cutoff << " ("
+                 << packed_time / best_time << "x sobre empaquetado)\n";
+        } else {
+            cout << "  -> Strassen no supera al empaquetado en N=" << N << "\n";
+        }
+        cout << string(65, '-') << "\n";
+    }
+
+    save_bench_report("7_strassen");
+    return 0;
+}
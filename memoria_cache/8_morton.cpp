@@ -0,0 +1,89 @@
+// g++ -O3 -std=c++20 -pthread 8_morton.cpp -o morton && ./morton
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <map>
+
+#include "autotuner.hpp"
+#include "morton.hpp"
+#include "../comun/benchmark.hpp"
+
+using namespace std;
+
+// Inicializar matrices con valores aleatorios
+void init_matrices(Matrix<real>& A, Matrix<real>& B, mt19937_64& rng) {
+    uniform_real_distribution<real> dist(0.0, 1.0);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+}
+
+int main() {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    // Potencias de 2 y tamaños que no lo son (el layout Morton rellena)
+    const vector<size_t> sizes = {256, 300, 512, 600, 768, 1000, 1024};
+
+    map<size_t, BlockShape> tuned;
+    for (size_t N : sizes) tuned[N] = tuned_block_shape(N);
+
+    mt19937_64 rng(123456);
+
+    cout << fixed << setprecision(3);
+    cout << "=== CACHE-OBLIVIOUS (MORTON) vs BLOQUES AUTOTUNEADO ===\n\n";
+    cout << setw(6) << "N" << setw(12) << "Bloque" << setw(11) << "Bloques(s)"
+         << setw(10) << "Tile" << setw(8) << "Pad"
+         << setw(11) << "Morton(s)" << setw(13) << "Conversion" << setw(10) << "Speedup"
+         << setw(12) << "Error max" << "\n";
+    cout << string(93, '-') << "\n";
+
+    for (size_t N : sizes) {
+        Matrix<real> A(N), B(N), C(N), C_morton(N);
+        init_matrices(A, B, rng);
+
+        const string prefix = "N=" + to_string(N) + "/";
+        double blocked_time = run_benchmark(prefix + "bloques/" + shape_label(tuned[N]), [&]() {
+            matmul_blocked(A, B, C, tuned[N]);
+        }).median;
+
+        MortonMatrix Am(N), Bm(N), Cm(N);
+
+        // Conversión de ida (A, B) y vuelta (C), medida aparte del producto
+        double convert_time = run_benchmark(prefix + "conversion", [&]() {
+            to_morton(A, Am);
+            to_morton(B, Bm);
+            from_morton(Cm, C_morton);
+        }).median;
+
+        double morton_time = run_benchmark(prefix + "morton", [&]() {
+            matmul_morton(Am, Bm, Cm);
+        }).median;
+        from_morton(Cm, C_morton);
+
+        double max_err = 0.0;
+        for (size_t i = 0; i < N; ++i)
+            for (size_t j = 0; j < N; ++j)
+                max_err = max(max_err, fabs(C(i,j) - C_morton(i,j)));
+
+        cout << setw(6) << N << setw(12) << shape_label(tuned[N])
+             << setw(11) << blocked_time
+             << setw(10) << (to_string(Cm.tile) + "x" + to_string(Cm.tiles_per_side()))
+             << setw(8) << Cm.padded() - N
+             << setw(11) << morton_time << setw(13) << convert_time
+             << setw(10) << blocked_time / morton_time
+             << setw(12) << scientific << setprecision(1) << max_err
+             << fixed << setprecision(3) << "\n";
+    }
+    cout << string(93, '-') << "\n";
+    cout << "Tile: T x 2^L (tiles por lado); Pad: filas/columnas de relleno\n";
+
+    save_bench_report("8_morton");
+    return 0;
+}
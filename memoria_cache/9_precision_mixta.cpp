@@ -0,0 +1,112 @@
+// g++ -O3 -std=c++20 -pthread 9_precision_mixta.cpp -o mixta && ./mixta
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <iomanip>
+#include <cmath>
+#include <string>
+
+#include "gemm_empaquetado.hpp"
+#include "gemm_mixto.hpp"
+#include "../comun/benchmark.hpp"
+
+using namespace std;
+
+// Valores en [-1, 1) para que la cuantización use todo el rango de int8
+void init_matrices(Matrix<real>& A, Matrix<real>& B, mt19937_64& rng) {
+    uniform_real_distribution<real> dist(-1.0, 1.0);
+    for (size_t i = 0; i < A.rows(); ++i) {
+        for (size_t j = 0; j < A.cols(); ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+}
+
+// Error relativo: max |C - ref| / max |ref|; `scale` convierte C a real
+template <typename Acc>
+double relative_error(const Matrix<Acc>& C, const Matrix<real>& ref, double scale = 1.0) {
+    double max_diff = 0.0, max_ref = 0.0;
+    for (size_t i = 0; i < ref.rows(); ++i) {
+        for (size_t j = 0; j < ref.cols(); ++j) {
+            max_diff = max(max_diff, fabs(static_cast<double>(C(i,j)) / scale - ref(i,j)));
+            max_ref = max(max_ref, fabs(ref(i,j)));
+        }
+    }
+    return max_diff / max_ref;
+}
+
+int main() {
+    ios::sync_with_stdio(false);
+    cin.tie(nullptr);
+
+    const vector<size_t> sizes = {256, 512, 1024};
+    const BlockShape shape{32, 512, 64};
+
+    mt19937_64 rng(123456);
+
+    cout << fixed << setprecision(3);
+    cout << "=== GEMM EN PRECISION MIXTA (tile " << shape_label(shape) << ") ===\n";
+    cout << "(error relativo: max|C - C_double| / max|C_double|)\n\n";
+    cout << setw(6) << "N" << setw(21) << "Tipo" << setw(11) << "Tiempo(s)"
+         << setw(10) << "GOP/s" << setw(10) << "Speedup" << setw(12) << "Error rel" << "\n";
+    cout << string(70, '-') << "\n";
+
+    for (size_t N : sizes) {
+        Matrix<real> A(N), B(N), C_ref(N), C(N);
+        const string prefix = "N=" + to_string(N) + "/";
+        init_matrices(A, B, rng);
+
+        auto print_row = [&](const string& type, double time, double base_time, double err) {
+            cout << setw(6) << N << setw(21) << type << setw(11) << time
+                 << setw(10) << 2.0 * N * N * N / time * 1e-9
+                 << setw(10) << base_time / time
+                 << setw(12) << scientific << setprecision(2) << err
+                 << fixed << setprecision(3) << "\n";
+        };
+
+        // Referencia double con el mismo kernel
+        double double_time = run_benchmark(prefix + "double", [&]() {
+            matmul_mixed<double, double>(A, B, C_ref, shape);
+        }).median;
+        print_row("double", double_time, double_time, 0.0);
+
+        double packed_time = run_benchmark(prefix + "double_empaquetado", [&]() {
+            matmul_packed(A, B, C);
+        }).median;
+        print_row("double empaquetado", packed_time, double_time, relative_error(C, C_ref));
+
+        // float32
+        Matrix<float> Af(N), Bf(N), Cf(N);
+        convert_matrix<float>(A, Af);
+        convert_matrix<float>(B, Bf);
+        double float_time = run_benchmark(prefix + "float", [&]() {
+            matmul_mixed<float, float>(Af, Bf, Cf, shape);
+        }).median;
+        print_row("float", float_time, double_time, relative_error(Cf, C_ref));
+
+        // bf16 almacenado, acumulación en float
+        Matrix<bf16> Ah(N), Bh(N);
+        convert_matrix<bf16>(A, Ah);
+        convert_matrix<bf16>(B, Bh);
+        double bf16_time = run_benchmark(prefix + "bf16", [&]() {
+            matmul_mixed<bf16, float>(Ah, Bh, Cf, shape);
+        }).median;
+        print_row("bf16 -> float", bf16_time, double_time, relative_error(Cf, C_ref));
+
+        // int8 cuantizado, acumulación en int32
+        Matrix<int8_t> Aq(N), Bq(N);
+        Matrix<int32_t> Cq(N);
+        double scale = quantize_int8(A, Aq) * quantize_int8(B, Bq);
+        double int8_time = run_benchmark(prefix + "int8", [&]() {
+            matmul_mixed<int8_t, int32_t>(Aq, Bq, Cq, shape);
+        }).median;
+        print_row("int8 -> int32", int8_time, double_time, relative_error(Cq, C_ref, scale));
+
+        cout << string(70, '-') << "\n";
+    }
+
+    save_bench_report("9_precision_mixta");
+    return 0;
+}
@@ -0,0 +1,159 @@
+// Arena de memoria para matrices, respaldada por páginas grandes.
+//
+// Con N >= 2048 una matriz de doubles ocupa miles de páginas de 4 KB y los
+// recorridos por columnas de B (clásico, bloques) cambian de página en cada
+// fila, así que fallan en el TLB casi en cada acceso. La arena reserva
+// regiones alineadas a 2 MB e intenta, en este orden:
+//   1. MAP_HUGETLB: páginas del pool de hugetlbfs (requiere vm.nr_hugepages > 0)
+//   2. madvise(MADV_HUGEPAGE): páginas grandes transparentes (THP en
+//      "always" o "madvise")
+//   3. páginas de 4 KB
+// Una región de 2 MB cubre con una sola entrada de TLB lo que antes eran 512.
+//
+// Las matrices se reparten de la región en orden (bump allocation),
+// alineadas a 64 bytes, y reset() las libera todas juntas sin devolver la
+// memoria: entre repeticiones o tamaños de un benchmark no se vuelve a pedir
+// memoria al sistema ni a ponerla en cero. Al contrario que Matrix, lo que
+// devuelve matrix() no se inicializa (tras reset() conserva lo anterior).
+#pragma once
+
+#include <sys/mman.h>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+#include "cpu_info.hpp"
+#include "matriz.hpp"
+
+enum class PageMode { HugeTLB, Transparent, Small };
+
+inline const char* page_mode_name(PageMode m) {
+    switch (m) {
+        case PageMode::HugeTLB: return "hugetlb";
+        case PageMode::Transparent: return "thp";
+        default: return "4k";
+    }
+}
+
+// THP desactivado del todo ("[never]"): madvise no falla pero no sirve
+inline bool thp_enabled() {
+    const std::string line = read_first_line("/sys/kernel/mm/transparent_hugepage/enabled");
+    return !line.empty() && line.find("[never]") == std::string::npos;
+}
+
+class MatrixArena {
+    struct Region {
+        char* base;
+        size_t size;
+        size_t used;
+        PageMode mode;
+    };
+    std::vector<Region> regions_;
+    PageMode preferred_;
+    size_t min_region_;
+
+    // Región de `bytes` (múltiplo de 2 MB) alineada a 2 MB, con el primer
+    // modo de página que funcione a partir de `preferred`
+    static Region map_region(size_t bytes, PageMode preferred) {
+        bytes = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+        const int prot = PROT_READ | PROT_WRITE;
+#if defined(MAP_HUGETLB)
+        if (preferred == PageMode::HugeTLB) {
+            void* p = mmap(nullptr, bytes, prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) return {static_cast<char*>(p), bytes, 0, PageMode::HugeTLB};
+        }
+#endif
+        // mmap solo garantiza 4 KB: se mapean 2 MB de más y se recortan los bordes
+        const size_t padded = bytes + HUGE_PAGE;
+        void* raw = mmap(nullptr, padded, prot, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        const uintptr_t start = (reinterpret_cast<uintptr_t>(raw) + HUGE_PAGE - 1) & ~(uintptr_t(HUGE_PAGE) - 1);
+        const size_t head = start - reinterpret_cast<uintptr_t>(raw);
+        if (head > 0) munmap(raw, head);
+        if (padded - head - bytes > 0) munmap(reinterpret_cast<char*>(start) + bytes, padded - head - bytes);
+
+        char* base = reinterpret_cast<char*>(start);
+        PageMode mode = PageMode::Small;
+#if defined(MADV_HUGEPAGE)
+        if (preferred != PageMode::Small) {
+            if (thp_enabled() && madvise(base, bytes, MADV_HUGEPAGE) == 0) mode = PageMode::Transparent;
+        } else {
+            // THP en "always" daría páginas grandes igual
+            madvise(base, bytes, MADV_NOHUGEPAGE);
+        }
+#endif
+        return {base, bytes, 0, mode};
+    }
+
+    void release() {
+        for (const Region& r : regions_) munmap(r.base, r.size);
+        regions_.clear();
+    }
+
+    void* allocate(size_t bytes) {
+        bytes = std::max(CACHE_LINE, (bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE);
+        for (Region& r : regions_) {
+            if (r.size - r.used >= bytes) {
+                void* p = r.base + r.used;
+                r.used += bytes;
+                return p;
+            }
+        }
+        regions_.push_back(map_region(std::max(bytes, min_region_), preferred_));
+        regions_.back().used = bytes;
+        return regions_.back().base;
+    }
+
+public:
+    // preferred: primer modo a intentar (HugeTLB prueba los tres, Small
+    // fuerza páginas de 4 KB); min_region: tamaño mínimo de cada región
+    explicit MatrixArena(PageMode preferred = PageMode::HugeTLB, size_t min_region = 32 * 1024 * 1024)
+        : preferred_(preferred), min_region_(min_region) {}
+    ~MatrixArena() { release(); }
+
+    MatrixArena(const MatrixArena&) = delete;
+    MatrixArena& operator=(const MatrixArena&) = delete;
+
+    // Deja una sola región con al menos `bytes` libres (sin matrices vivas):
+    // con el tamaño del caso más grande el barrido entero sale de ella
+    void reserve(size_t bytes) {
+        if (regions_.size() == 1 && regions_[0].used == 0 && regions_[0].size >= bytes) return;
+        release();
+        regions_.push_back(map_region(std::max(bytes, min_region_), preferred_));
+    }
+
+    // Libera todas las matrices. Si la arena creció en varias regiones se
+    // reemplazan por una del tamaño total, así desde la segunda vuelta todo
+    // sale de la misma región
+    void reset() {
+        if (regions_.size() > 1) {
+            size_t total = 0;
+            for (const Region& r : regions_) total += r.size;
+            reserve(total);
+        }
+        for (Region& r : regions_) r.used = 0;
+    }
+
+    // Matriz rows x cols (ld = 0 usa la dimensión lógica) sin inicializar
+    template <typename T = real, Layout L = Layout::RowMajor>
+    MatrixView<T, L> matrix(size_t rows, size_t cols, size_t ld = 0) {
+        static_assert(std::is_trivially_copyable_v<T>, "solo tipos triviales");
+        if (ld == 0) ld = L == Layout::RowMajor ? cols : rows;
+        const size_t count = ld * (L == Layout::RowMajor ? rows : cols);
+        return {static_cast<T*>(allocate(count * sizeof(T))), rows, cols, ld};
+    }
+
+    size_t reserved() const {
+        size_t total = 0;
+        for (const Region& r : regions_) total += r.size;
+        return total;
+    }
+    size_t used() const {
+        size_t total = 0;
+        for (const Region& r : regions_) total += r.used;
+        return total;
+    }
+
+    // Modo de página que se consiguió (el pedido si aún no hay regiones)
+    PageMode mode() const { return regions_.empty() ? preferred_ : regions_.front().mode; }
+};
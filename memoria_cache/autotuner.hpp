@@ -0,0 +1,152 @@
+// Autotuner del tamaño de bloque de matmul_blocked.
+//
+// La primera vez que se pide un tamaño para una combinación (CPU, cachés,
+// rango de N) se buscan tiles independientes para los bucles i, j y k; el
+// ganador se guarda en un archivo de caché y las ejecuciones siguientes lo
+// reutilizan sin volver a medir. El archivo es "tuning_bloques.cache" en el
+// directorio actual o la ruta de la variable PARALELA_TUNING_CACHE.
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "cpu_info.hpp"
+#include "gemm_bloques.hpp"
+
+// Los resultados valen para N en [lo, 2*lo), lo potencia de 2
+inline size_t tuning_range_low(size_t N) {
+    size_t lo = 1;
+    while (lo * 2 <= N) lo *= 2;
+    return lo;
+}
+
+inline std::string tuning_key(const CpuInfo& cpu, size_t N) {
+    size_t lo = tuning_range_low(N);
+    return cpu.model
+        + "|L1d=" + std::to_string(cpu.l1d.size / 1024) + "K"
+        + "|L2=" + std::to_string(cpu.l2.size / 1024) + "K"
+        + "|L3=" + std::to_string(cpu.l3.size / 1024) + "K"
+        + "|N=" + std::to_string(lo) + "-" + std::to_string(2 * lo - 1);
+}
+
+inline std::string tuning_cache_path() {
+    const char* path = std::getenv("PARALELA_TUNING_CACHE");
+    return path ? path : "tuning_bloques.cache";
+}
+
+// Formato del archivo: una entrada por línea, "clave<TAB>bi bj bk".
+// Si una clave aparece varias veces, gana la última.
+inline bool load_tuned_shape(const std::string& path, const std::string& key, BlockShape& shape) {
+    std::ifstream file(path);
+    std::string line;
+    bool found = false;
+    while (std::getline(file, line)) {
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos || line.substr(0, tab) != key) continue;
+        std::istringstream values(line.substr(tab + 1));
+        BlockShape parsed;
+        if (values >> parsed.bi >> parsed.bj >> parsed.bk && parsed.bi && parsed.bj && parsed.bk) {
+            shape = parsed;
+            found = true;
+        }
+    }
+    return found;
+}
+
+inline void save_tuned_shape(const std::string& path, const std::string& key, const BlockShape& shape) {
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Aviso: no se pudo escribir la caché de tuning " << path << "\n";
+        return;
+    }
+    file << key << '\t' << shape.bi << ' ' << shape.bj << ' ' << shape.bk << '\n';
+}
+
+// Búsqueda: barrido de tiles cuadrados y luego descenso por coordenadas,
+// variando un nivel de bucle por vez, sobre un N representativo del rango
+inline BlockShape autotune_block_shape(size_t N) {
+    const std::vector<size_t> candidates = {8, 16, 32, 64, 128, 256};
+    const size_t n = std::clamp<size_t>(tuning_range_low(N), 64, 512);
+    const int repeats = 2;
+
+    Matrix<real> A(n), B(n), C(n);
+    std::mt19937_64 rng(123456);
+    std::uniform_real_distribution<real> dist(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            A(i,j) = dist(rng);
+            B(i,j) = dist(rng);
+        }
+    }
+
+    std::map<std::tuple<size_t, size_t, size_t>, double> measured;
+    auto measure = [&](const BlockShape& s) {
+        auto key = std::make_tuple(s.bi, s.bj, s.bk);
+        auto it = measured.find(key);
+        if (it != measured.end()) return it->second;
+        double best = 1e300;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::high_resolution_clock::now();
+            matmul_blocked(A, B, C, s);
+            auto end = std::chrono::high_resolution_clock::now();
+            best = std::min(best, std::chrono::duration<double>(end - start).count());
+        }
+        measured[key] = best;
+        return best;
+    };
+
+    BlockShape best{candidates[0], candidates[0], candidates[0]};
+    double best_time = measure(best);
+    for (size_t s : candidates) {
+        if (s > n) break;
+        double t = measure({s, s, s});
+        if (t < best_time) {
+            best = {s, s, s};
+            best_time = t;
+        }
+    }
+
+    // Un cambio solo se acepta si mejora más de un 2% (ruido de medición)
+    for (int pass = 0; pass < 2; ++pass) {
+        bool improved = false;
+        for (size_t BlockShape::*level : {&BlockShape::bi, &BlockShape::bj, &BlockShape::bk}) {
+            for (size_t s : candidates) {
+                if (s > n) break;
+                BlockShape trial = best;
+                trial.*level = s;
+                double t = measure(trial);
+                if (t < best_time * 0.98) {
+                    best = trial;
+                    best_time = t;
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) break;
+    }
+    return best;
+}
+
+// Tile para matmul_blocked con N dado: de la caché si existe, si no se
+// busca y se guarda
+inline BlockShape tuned_block_shape(size_t N) {
+    const std::string key = tuning_key(detect_cpu_info(), N);
+    const std::string path = tuning_cache_path();
+
+    BlockShape shape;
+    if (load_tuned_shape(path, key, shape)) return shape;
+
+    std::clog << "Autotuning de bloques para N=" << N << " (primera ejecucion en esta CPU)...\n";
+    shape = autotune_block_shape(N);
+    save_tuned_shape(path, key, shape);
+    std::clog << "  -> " << shape_label(shape) << " guardado en " << path << "\n";
+    return shape;
+}
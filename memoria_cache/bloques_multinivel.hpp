@@ -0,0 +1,60 @@
+// Blocking multinivel: un tile para L1, otro para L2 y otro para L3, cada
+// uno múltiplo del anterior y derivado de la geometría de caché detectada.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "cpu_info.hpp"
+#include "gemm_bloques.hpp"
+
+// levels[0] = tile de L1, levels[1] = L2, levels[2] = L3
+struct MultiLevelTiling {
+    BlockShape levels[3];
+};
+
+// Mayor tile cuadrado t (múltiplo de `multiple`) cuyos tres bloques de A, B
+// y C (3 * t^2 reales) ocupan como mucho la mitad de la caché; la otra mitad
+// queda para las líneas que aún no se desalojaron y para los conflictos.
+inline size_t tile_for_cache(size_t cache_bytes, size_t multiple) {
+    size_t t = static_cast<size_t>(std::sqrt(cache_bytes / 2.0 / (3.0 * sizeof(real))));
+    t = (t / multiple) * multiple;
+    return std::max(t, multiple);
+}
+
+inline MultiLevelTiling tiling_from_caches(const CpuInfo& cpu) {
+    size_t t1 = tile_for_cache(cpu.l1d.size, 8);
+    size_t t2 = tile_for_cache(cpu.l2.size, t1);
+    size_t t3 = tile_for_cache(cpu.l3.size, t2);
+    return {{{t1, t1, t1}, {t2, t2, t2}, {t3, t3, t3}}};
+}
+
+// Recorre los tiles del nivel `level` dentro de la región [i0,i1)x[j0,j1)x[k0,k1)
+// y baja al nivel siguiente; debajo de L1 se hace el producto del bloque.
+inline void multilevel_block(ConstRealView A, ConstRealView B, RealView C,
+                             const MultiLevelTiling& t, int level,
+                             size_t i0, size_t i1, size_t j0, size_t j1,
+                             size_t k0, size_t k1) {
+    if (level < 0) {
+        block_update(A, B, C, i0, i1, j0, j1, k0, k1);
+        return;
+    }
+
+    const BlockShape& s = t.levels[level];
+    for (size_t ii = i0; ii < i1; ii += s.bi) {
+        for (size_t jj = j0; jj < j1; jj += s.bj) {
+            for (size_t kk = k0; kk < k1; kk += s.bk) {
+                multilevel_block(A, B, C, t, level - 1,
+                                 ii, std::min(ii + s.bi, i1),
+                                 jj, std::min(jj + s.bj, j1),
+                                 kk, std::min(kk + s.bk, k1));
+            }
+        }
+    }
+}
+
+// Multiplicación por bloques en tres niveles (L3 -> L2 -> L1)
+inline void matmul_blocked_multilevel(ConstRealView A, ConstRealView B, RealView C,
+                                      const MultiLevelTiling& t) {
+    C.fill(0.0);
+    multilevel_block(A, B, C, t, 2, 0, A.rows(), 0, B.cols(), 0, A.cols());
+}
@@ -0,0 +1,109 @@
+// Detección del modelo de CPU y de la geometría de caché de la máquina.
+// Lee sysfs (/sys/devices/system/cpu/cpu0/cache) y, si no está disponible,
+// recurre a sysconf(_SC_LEVEL*_CACHE_*).
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <cstddef>
+#include <unistd.h>
+
+struct CacheLevel {
+    int level;            // 1, 2, 3
+    size_t size;          // bytes
+    size_t line_size;     // bytes
+    size_t ways;          // asociatividad (0 = desconocida)
+};
+
+struct CpuInfo {
+    std::string model;
+    CacheLevel l1d{1, 32 * 1024, 64, 8};
+    CacheLevel l2{2, 256 * 1024, 64, 8};
+    CacheLevel l3{3, 8 * 1024 * 1024, 64, 16};
+};
+
+// Convierte "48K", "2048K", "30M" o "49152" a bytes
+inline size_t parse_cache_size(const std::string& text) {
+    if (text.empty()) return 0;
+    size_t value = std::stoull(text);
+    switch (text.back()) {
+        case 'K': return value * 1024;
+        case 'M': return value * 1024 * 1024;
+        case 'G': return value * 1024 * 1024 * 1024;
+        default:  return value;
+    }
+}
+
+inline std::string read_first_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+// Lee las entradas index* de sysfs; devuelve false si no existen
+inline bool read_sysfs_caches(CpuInfo& info) {
+    bool found = false;
+    for (int index = 0; index < 16; ++index) {
+        std::string dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+        std::string type = read_first_line(dir + "type");
+        if (type.empty()) break;
+        if (type == "Instruction") continue;
+
+        CacheLevel level;
+        level.level = std::stoi(read_first_line(dir + "level"));
+        level.size = parse_cache_size(read_first_line(dir + "size"));
+        std::string line = read_first_line(dir + "coherency_line_size");
+        level.line_size = line.empty() ? 64 : std::stoull(line);
+        std::string ways = read_first_line(dir + "ways_of_associativity");
+        level.ways = ways.empty() ? 0 : std::stoull(ways);
+        if (level.size == 0) continue;
+
+        if (level.level == 1) info.l1d = level;
+        else if (level.level == 2) info.l2 = level;
+        else if (level.level == 3) info.l3 = level;
+        found = true;
+    }
+    return found;
+}
+
+inline void read_sysconf_caches(CpuInfo& info) {
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+    long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    long l1_line = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+    long l1_ways = sysconf(_SC_LEVEL1_DCACHE_ASSOC);
+    long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    long l2_ways = sysconf(_SC_LEVEL2_CACHE_ASSOC);
+    long l3 = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    long l3_ways = sysconf(_SC_LEVEL3_CACHE_ASSOC);
+    if (l1 > 0) info.l1d = {1, size_t(l1), l1_line > 0 ? size_t(l1_line) : 64, l1_ways > 0 ? size_t(l1_ways) : 0};
+    if (l2 > 0) info.l2 = {2, size_t(l2), info.l1d.line_size, l2_ways > 0 ? size_t(l2_ways) : 0};
+    if (l3 > 0) info.l3 = {3, size_t(l3), info.l1d.line_size, l3_ways > 0 ? size_t(l3_ways) : 0};
+#else
+    (void)info;
+#endif
+}
+
+inline std::string read_cpu_model() {
+    std::ifstream file("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("model name", 0) == 0) {
+            size_t colon = line.find(':');
+            if (colon != std::string::npos) return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+    }
+    return "desconocido";
+}
+
+// Detecta la CPU una sola vez; los valores por defecto de CpuInfo se usan
+// cuando ni sysfs ni sysconf informan un nivel
+inline const CpuInfo& detect_cpu_info() {
+    static const CpuInfo info = [] {
+        CpuInfo detected;
+        detected.model = read_cpu_model();
+        if (!read_sysfs_caches(detected)) read_sysconf_caches(detected);
+        return detected;
+    }();
+    return info;
+}
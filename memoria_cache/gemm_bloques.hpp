@@ -0,0 +1,83 @@
+// Multiplicación clásica y por bloques sobre arreglos aplanados row-major.
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include "matriz.hpp"
+
+// Tamaño de tile para cada nivel de bucle (i, j, k); no tiene que ser cuadrado
+struct BlockShape {
+    size_t bi, bj, bk;
+};
+
+inline std::string shape_label(const BlockShape& s) {
+    if (s.bi == s.bj && s.bj == s.bk) return std::to_string(s.bi);
+    return std::to_string(s.bi) + "x" + std::to_string(s.bj) + "x" + std::to_string(s.bk);
+}
+
+// Los kernels son plantillas sobre el tipo de los elementos (T) y el del
+// acumulador/resultado (Acc); por defecto ambos son `real`. Los parámetros
+// usan type_identity para que T y Acc no se deduzcan y las Matrix<real>
+// se conviertan a vista sin indicar tipos: matmul_classic(A, B, C) sigue
+// funcionando y una variante mixta se pide con matmul_classic<int8_t, int32_t>.
+template <typename T>
+using ConstViewOf = MatrixView<const std::type_identity_t<T>>;
+template <typename T>
+using ViewOf = MatrixView<std::type_identity_t<T>>;
+
+// Multiplicación clásica C = A * B (orden ijk). A es M x K, B es K x N.
+template <typename T = real, typename Acc = T>
+void matmul_classic(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C) {
+    const size_t M = A.rows(), K = A.cols(), N = B.cols();
+    for (size_t i = 0; i < M; ++i) {
+        for (size_t j = 0; j < N; ++j) {
+            Acc sum = 0;
+            for (size_t k = 0; k < K; ++k) {
+                sum += static_cast<Acc>(A(i,k)) * static_cast<Acc>(B(k,j));
+            }
+            C(i,j) = sum;
+        }
+    }
+}
+
+// Acumula en C el producto del bloque [i0,i1) x [j0,j1) x [k0,k1)
+template <typename T = real, typename Acc = T>
+void block_update(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C,
+                  size_t i0, size_t i1, size_t j0, size_t j1,
+                  size_t k0, size_t k1) {
+    for (size_t i = i0; i < i1; ++i) {
+        for (size_t j = j0; j < j1; ++j) {
+            Acc sum = C(i,j);
+            for (size_t k = k0; k < k1; ++k) {
+                sum += static_cast<Acc>(A(i,k)) * static_cast<Acc>(B(k,j));
+            }
+            C(i,j) = sum;
+        }
+    }
+}
+
+// Multiplicación por bloques con un tile distinto por nivel de bucle
+template <typename T = real, typename Acc = T>
+void matmul_blocked(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, BlockShape s) {
+    const size_t M = A.rows(), K = A.cols(), N = B.cols();
+    C.fill(0);
+
+    for (size_t ii = 0; ii < M; ii += s.bi) {
+        for (size_t jj = 0; jj < N; jj += s.bj) {
+            for (size_t kk = 0; kk < K; kk += s.bk) {
+                // Límites del bloque y multiplicación del bloque
+                block_update<T, Acc>(A, B, C,
+                                     ii, std::min(ii + s.bi, M),
+                                     jj, std::min(jj + s.bj, N),
+                                     kk, std::min(kk + s.bk, K));
+            }
+        }
+    }
+}
+
+// Multiplicación por bloques cuadrados
+template <typename T = real, typename Acc = T>
+void matmul_blocked(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, size_t block_size) {
+    matmul_blocked<T, Acc>(A, B, C, BlockShape{block_size, block_size, block_size});
+}
@@ -0,0 +1,204 @@
+// Motor de multiplicación empaquetada estilo GotoBLAS compartido por los
+// benchmarks de memoria_cache/.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "matriz.hpp"
+#include "../comun/cpu_dispatch.hpp"
+#if defined(ISA_X86)
+#include <immintrin.h>
+#endif
+
+// ============================================
+// PARÁMETROS
+// ============================================
+// Tile de registros MR x NR de cada variante del micro-kernel (se elige al
+// arrancar según la CPU, ver cpu_dispatch.hpp):
+//   AVX-512: 8 x 16 (16 zmm acumuladores), AVX2+FMA: 6 x 8 (12 ymm), SSE2: 4 x 4
+constexpr size_t MR_MAX = 8, NR_MAX = 16;
+
+// Bloques de caché: panel KC x NR de B en L1, bloque MC x KC de A en L2,
+// panel KC x NC de B en L3. MC es múltiplo de todos los MR y NC de los NR.
+constexpr size_t MC = 96, KC = 256, NC = 2048;
+
+// Paneles empaquetados de A (MC x KC) y B (KC x NC), alineados a 64 bytes.
+// Cada hilo usa los suyos.
+struct PackBuffers {
+    aligned_array<real> Ap = make_aligned_array<real>(MC * KC);
+    aligned_array<real> Bp = make_aligned_array<real>(KC * NC);
+};
+
+// ============================================
+// EMPAQUETADO
+// ============================================
+// Empaqueta el bloque de A (mc x kc) en paneles de MR filas: para cada k,
+// las MR entradas de la columna quedan contiguas. Relleno con ceros al borde.
+inline void pack_A(ConstRealView A, real* Ap, size_t MR) {
+    const size_t mc = A.rows(), kc = A.cols();
+    for (size_t p = 0; p < mc; p += MR) {
+        size_t mr = std::min(MR, mc - p);
+        for (size_t k = 0; k < kc; ++k) {
+            for (size_t i = 0; i < mr; ++i) *Ap++ = A(p + i, k);
+            for (size_t i = mr; i < MR; ++i) *Ap++ = 0.0;
+        }
+    }
+}
+
+// Empaqueta el bloque de B (kc x nc) en paneles de NR columnas: para cada k,
+// las NR entradas de la fila quedan contiguas. Relleno con ceros al borde.
+inline void pack_B(ConstRealView B, real* Bp, size_t NR) {
+    const size_t kc = B.rows(), nc = B.cols();
+    for (size_t q = 0; q < nc; q += NR) {
+        size_t nr = std::min(NR, nc - q);
+        for (size_t k = 0; k < kc; ++k) {
+            for (size_t j = 0; j < nr; ++j) *Bp++ = B(k, q + j);
+            for (size_t j = nr; j < NR; ++j) *Bp++ = 0.0;
+        }
+    }
+}
+
+// ============================================
+// MICRO-KERNELS (una variante por ISA)
+// ============================================
+// C[MR x NR] += Ap (MR x kc) * Bp (kc x NR), acumulando en registros
+typedef void (*MicroKernelFn)(size_t kc, const real* Ap, const real* Bp, real* C, size_t ldc);
+
+struct MicroKernel {
+    size_t mr, nr;
+    MicroKernelFn fn;
+};
+
+// Base: bucles escalares que el compilador vectoriza con los flags del build
+inline void micro_kernel_sse2(size_t kc, const real* Ap, const real* Bp, real* C, size_t ldc) {
+    constexpr size_t MR = 4, NR = 4;
+    real c[MR][NR] = {};
+    for (size_t k = 0; k < kc; ++k) {
+        for (size_t i = 0; i < MR; ++i)
+            for (size_t j = 0; j < NR; ++j)
+                c[i][j] += Ap[i] * Bp[j];
+        Ap += MR;
+        Bp += NR;
+    }
+    for (size_t i = 0; i < MR; ++i)
+        for (size_t j = 0; j < NR; ++j)
+            C[i * ldc + j] += c[i][j];
+}
+
+#if defined(ISA_X86)
+ISA_TARGET_AVX2
+inline void micro_kernel_avx2(size_t kc, const real* Ap, const real* Bp, real* C, size_t ldc) {
+    constexpr size_t MR = 6, NR = 8;
+    __m256d c[MR][2];
+    for (size_t i = 0; i < MR; ++i) c[i][0] = c[i][1] = _mm256_setzero_pd();
+    for (size_t k = 0; k < kc; ++k) {
+        __m256d b0 = _mm256_load_pd(Bp);
+        __m256d b1 = _mm256_load_pd(Bp + 4);
+        for (size_t i = 0; i < MR; ++i) {
+            __m256d a = _mm256_broadcast_sd(Ap + i);
+            c[i][0] = _mm256_fmadd_pd(a, b0, c[i][0]);
+            c[i][1] = _mm256_fmadd_pd(a, b1, c[i][1]);
+        }
+        Ap += MR;
+        Bp += NR;
+    }
+    for (size_t i = 0; i < MR; ++i) {
+        real* c_row = C + i * ldc;
+        _mm256_storeu_pd(c_row,     _mm256_add_pd(_mm256_loadu_pd(c_row),     c[i][0]));
+        _mm256_storeu_pd(c_row + 4, _mm256_add_pd(_mm256_loadu_pd(c_row + 4), c[i][1]));
+    }
+}
+
+ISA_TARGET_AVX512
+inline void micro_kernel_avx512(size_t kc, const real* Ap, const real* Bp, real* C, size_t ldc) {
+    constexpr size_t MR = 8, NR = 16;
+    __m512d c[MR][2];
+    for (size_t i = 0; i < MR; ++i) c[i][0] = c[i][1] = _mm512_setzero_pd();
+    for (size_t k = 0; k < kc; ++k) {
+        __m512d b0 = _mm512_load_pd(Bp);
+        __m512d b1 = _mm512_load_pd(Bp + 8);
+        for (size_t i = 0; i < MR; ++i) {
+            __m512d a = _mm512_set1_pd(Ap[i]);
+            c[i][0] = _mm512_fmadd_pd(a, b0, c[i][0]);
+            c[i][1] = _mm512_fmadd_pd(a, b1, c[i][1]);
+        }
+        Ap += MR;
+        Bp += NR;
+    }
+    for (size_t i = 0; i < MR; ++i) {
+        real* c_row = C + i * ldc;
+        _mm512_storeu_pd(c_row,     _mm512_add_pd(_mm512_loadu_pd(c_row),     c[i][0]));
+        _mm512_storeu_pd(c_row + 8, _mm512_add_pd(_mm512_loadu_pd(c_row + 8), c[i][1]));
+    }
+}
+#endif
+
+inline MicroKernel micro_kernel_for(Isa isa) {
+#if defined(ISA_X86)
+    if (isa == Isa::AVX512) return {8, 16, micro_kernel_avx512};
+    if (isa == Isa::AVX2) return {6, 8, micro_kernel_avx2};
+#endif
+    (void)isa;
+    return {4, 4, micro_kernel_sse2};
+}
+
+// Micro-kernel de la variante activa (active_isa())
+inline const MicroKernel& active_micro_kernel() {
+    static const MicroKernel uk = micro_kernel_for(active_isa());
+    return uk;
+}
+
+// ============================================
+// KERNELS
+// ============================================
+// Macro-kernel: recorre el bloque empaquetado mc x nc en tiles MR x NR.
+// Los tiles incompletos del borde se calculan en un buffer temporal.
+inline void macro_kernel(const MicroKernel& uk, size_t mc, size_t nc, size_t kc,
+                         const real* Ap, const real* Bp, real* C, size_t ldc) {
+    const size_t MR = uk.mr, NR = uk.nr;
+    for (size_t jr = 0; jr < nc; jr += NR) {
+        size_t nr = std::min(NR, nc - jr);
+        for (size_t ir = 0; ir < mc; ir += MR) {
+            size_t mr = std::min(MR, mc - ir);
+            const real* a = Ap + ir * kc;
+            const real* b = Bp + jr * kc;
+            if (mr == MR && nr == NR) {
+                uk.fn(kc, a, b, C + ir * ldc + jr, ldc);
+            } else {
+                alignas(64) real tmp[MR_MAX * NR_MAX] = {};
+                uk.fn(kc, a, b, tmp, NR);
+                for (size_t i = 0; i < mr; ++i)
+                    for (size_t j = 0; j < nr; ++j)
+                        C[(ir + i) * ldc + jr + j] += tmp[i * NR + j];
+            }
+        }
+    }
+}
+
+// Acumula en C[i0:i1, j0:j1] el producto de las filas i0:i1 de A por las
+// columnas j0:j1 de B usando los paneles de buf
+inline void matmul_packed_tile(ConstRealView A, ConstRealView B, RealView C,
+                               size_t i0, size_t i1, size_t j0, size_t j1,
+                               PackBuffers& buf) {
+    const size_t K = A.cols();
+    const MicroKernel& uk = active_micro_kernel();
+    for (size_t jc = j0; jc < j1; jc += NC) {
+        size_t nc = std::min(NC, j1 - jc);
+        for (size_t pc = 0; pc < K; pc += KC) {
+            size_t kc = std::min(KC, K - pc);
+            pack_B(B.block(pc, jc, kc, nc), buf.Bp.get(), uk.nr);
+            for (size_t ic = i0; ic < i1; ic += MC) {
+                size_t mc = std::min(MC, i1 - ic);
+                pack_A(A.block(ic, pc, mc, kc), buf.Ap.get(), uk.mr);
+                macro_kernel(uk, mc, nc, kc, buf.Ap.get(), buf.Bp.get(), &C(ic, jc), C.ld());
+            }
+        }
+    }
+}
+
+// Multiplicación empaquetada C = A * B con micro-kernel de registros
+inline void matmul_packed(ConstRealView A, ConstRealView B, RealView C) {
+    C.fill(0.0);
+    PackBuffers buf;
+    matmul_packed_tile(A, B, C, 0, A.rows(), 0, B.cols(), buf);
+}
@@ -0,0 +1,170 @@
+// GEMM en precisión mixta: elementos de tipo T y acumulación en Acc.
+//
+// Combinaciones que mide 9_precision_mixta:
+//   - float  x float  -> float  (el doble de elementos por registro que double)
+//   - bf16   x bf16   -> float  (bf16 solo como formato de almacenamiento)
+//   - int8_t x int8_t -> int32_t (cuantización simétrica por matriz)
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include "gemm_bloques.hpp"
+#include "../comun/cpu_dispatch.hpp"
+
+// ============================================
+// BF16 (emulado)
+// ============================================
+// Los 16 bits altos de un float: mismo rango que float y 8 bits de mantisa.
+// Las operaciones se hacen en float; bf16 solo reduce la memoria a la mitad.
+struct bf16 {
+    uint16_t bits = 0;
+
+    bf16() = default;
+    // Redondeo al par más cercano (NaN no aparece en estos benchmarks)
+    explicit bf16(float f) {
+        uint32_t u = std::bit_cast<uint32_t>(f);
+        u += 0x7FFF + ((u >> 16) & 1);
+        bits = static_cast<uint16_t>(u >> 16);
+    }
+    explicit operator float() const {
+        return std::bit_cast<float>(static_cast<uint32_t>(bits) << 16);
+    }
+};
+
+// ============================================
+// KERNEL
+// ============================================
+// Vector genérico de GCC de `Bytes` bytes de T. El bucle interno trabaja de a
+// MIXED_VEC_BYTES de Acc (un registro AVX-512: 8 double, 16 float o 16
+// int32); en AVX2 el compilador lo parte en 2 registros y en SSE2 en 4. Con
+// el ancho escrito en el código el kernel se vectoriza también con -O2, y
+// lo que cambia con la precisión es cuántos elementos entran por registro.
+// `unaligned` sirve para leer de memoria en cualquier dirección (y con
+// cualquier tipo): con memcpy GCC arma los vectores de int8 byte por byte.
+template <typename T, size_t Bytes>
+struct VecOf {
+    typedef T type __attribute__((vector_size(Bytes)));
+    typedef T unaligned __attribute__((vector_size(Bytes), aligned(1), may_alias));
+};
+constexpr size_t MIXED_VEC_BYTES = 64;
+
+// MIXED_VEC_BYTES / sizeof(Acc) elementos de p convertidos a Acc: int8 se
+// extiende con signo y bf16 se corre a los 16 bits altos de un float
+template <typename T, typename Acc>
+ISA_INLINE void load_as_acc(const T* p, typename VecOf<Acc, MIXED_VEC_BYTES>::type& out) {
+    constexpr size_t lanes = MIXED_VEC_BYTES / sizeof(Acc);
+    if constexpr (std::is_same_v<T, bf16>) {
+        static_assert(std::is_same_v<Acc, float>, "bf16 se acumula en float");
+        using Bits = VecOf<uint16_t, 2 * lanes>;
+        using Wide = typename VecOf<uint32_t, 4 * lanes>::type;
+        const Wide wide = __builtin_convertvector(*reinterpret_cast<const typename Bits::unaligned*>(p), Wide) << 16;
+        out = (typename VecOf<Acc, MIXED_VEC_BYTES>::type)wide;  // mismos bits
+    } else if constexpr (std::is_integral_v<T> && sizeof(Acc) == 4 * sizeof(T)) {
+        // int8 -> int32 en dos pasos: en un solo paso GCC lo arma byte a byte
+        using In = VecOf<T, sizeof(T) * lanes>;
+        using Half = typename VecOf<int16_t, 2 * lanes>::type;
+        const Half half = __builtin_convertvector(*reinterpret_cast<const typename In::unaligned*>(p), Half);
+        out = __builtin_convertvector(half, typename VecOf<Acc, MIXED_VEC_BYTES>::type);
+    } else {
+        using In = VecOf<T, sizeof(T) * lanes>;
+        const typename In::type v = *reinterpret_cast<const typename In::unaligned*>(p);
+        out = __builtin_convertvector(v, typename VecOf<Acc, MIXED_VEC_BYTES>::type);
+    }
+}
+
+// C = A * B por bloques, con el bloque en orden ikj: el bucle interno recorre
+// una fila de B y otra de C de forma contigua, un vector de Acc por paso y
+// el resto del bloque elemento por elemento.
+template <typename T, typename Acc>
+ISA_INLINE void matmul_mixed_body(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, BlockShape s) {
+    using Vec = typename VecOf<Acc, MIXED_VEC_BYTES>::type;
+    constexpr size_t lanes = MIXED_VEC_BYTES / sizeof(Acc);
+    const size_t M = A.rows(), K = A.cols(), N = B.cols();
+    C.fill(0);
+
+    for (size_t ii = 0; ii < M; ii += s.bi) {
+        size_t i_end = std::min(ii + s.bi, M);
+        for (size_t kk = 0; kk < K; kk += s.bk) {
+            size_t k_end = std::min(kk + s.bk, K);
+            for (size_t jj = 0; jj < N; jj += s.bj) {
+                size_t j_end = std::min(jj + s.bj, N);
+                for (size_t i = ii; i < i_end; ++i) {
+                    Acc* c_row = &C(i, 0);
+                    for (size_t k = kk; k < k_end; ++k) {
+                        const Acc a = static_cast<Acc>(A(i,k));
+                        const Vec va = Vec{} + a;
+                        const T* b_row = &B(k, 0);
+                        size_t j = jj;
+                        for (; j + lanes <= j_end; j += lanes) {
+                            Vec b;
+                            load_as_acc<T, Acc>(b_row + j, b);
+                            auto& c = *reinterpret_cast<typename VecOf<Acc, MIXED_VEC_BYTES>::unaligned*>(c_row + j);
+                            c += va * b;
+                        }
+                        for (; j < j_end; ++j) {
+                            c_row[j] += a * static_cast<Acc>(b_row[j]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Las tres variantes ISA de cpu_dispatch.hpp, como micro_kernel_* en
+// gemm_empaquetado.hpp (ISA_VARIANTS no admite plantillas)
+template <typename T, typename Acc>
+void matmul_mixed_sse2(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, BlockShape s) {
+    matmul_mixed_body<T, Acc>(A, B, C, s);
+}
+
+#if defined(ISA_X86)
+template <typename T, typename Acc>
+ISA_TARGET_AVX2 void matmul_mixed_avx2(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, BlockShape s) {
+    matmul_mixed_body<T, Acc>(A, B, C, s);
+}
+
+template <typename T, typename Acc>
+ISA_TARGET_AVX512 void matmul_mixed_avx512(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, BlockShape s) {
+    matmul_mixed_body<T, Acc>(A, B, C, s);
+}
+#endif
+
+template <typename T, typename Acc>
+void matmul_mixed(ConstViewOf<T> A, ConstViewOf<T> B, ViewOf<Acc> C, BlockShape s) {
+#if defined(ISA_X86)
+    static void (*const variant)(ConstViewOf<T>, ConstViewOf<T>, ViewOf<Acc>, BlockShape) =
+        isa_select(&matmul_mixed_sse2<T, Acc>, &matmul_mixed_avx2<T, Acc>, &matmul_mixed_avx512<T, Acc>);
+    variant(A, B, C, s);
+#else
+    matmul_mixed_body<T, Acc>(A, B, C, s);
+#endif
+}
+
+// ============================================
+// CONVERSIONES
+// ============================================
+// Copia con conversión de tipo (double -> float, double -> bf16)
+template <typename T>
+void convert_matrix(ConstRealView src, ViewOf<T> dst) {
+    for (size_t i = 0; i < src.rows(); ++i)
+        for (size_t j = 0; j < src.cols(); ++j)
+            dst(i,j) = T(static_cast<float>(src(i,j)));
+}
+
+// Cuantización simétrica a int8: q = round(x * scale), scale = 127 / max|x|.
+// Devuelve scale; el valor real es q / scale.
+inline double quantize_int8(ConstRealView src, ViewOf<int8_t> dst) {
+    double max_abs = 0.0;
+    for (size_t i = 0; i < src.rows(); ++i)
+        for (size_t j = 0; j < src.cols(); ++j)
+            max_abs = std::max(max_abs, std::fabs(src(i,j)));
+    double scale = max_abs > 0.0 ? 127.0 / max_abs : 1.0;
+    for (size_t i = 0; i < src.rows(); ++i)
+        for (size_t j = 0; j < src.cols(); ++j)
+            dst(i,j) = static_cast<int8_t>(std::lround(src(i,j) * scale));
+    return scale;
+}
@@ -0,0 +1,101 @@
+// GEMM multihilo: reparte C en una rejilla 2D de tiles, un tile por hilo,
+// o en tiles chicos que los hilos se roban (matmul_work_stealing).
+// Cada hilo empaqueta sus propios paneles de A y B (PackBuffers).
+#pragma once
+
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+#include "gemm_empaquetado.hpp"
+#include "../comun/work_stealing.hpp"
+
+// Reparte [0, n) en `parts` trozos múltiplos de `unit` (el último puede ser
+// menor) y devuelve en [begin, end) el trozo número p
+inline void split_range(size_t n, size_t parts, size_t unit, size_t p,
+                        size_t& begin, size_t& end) {
+    size_t units = (n + unit - 1) / unit;
+    size_t base = units / parts, rem = units % parts;
+    size_t first = p * base + std::min(p, rem);
+    size_t last = first + base + (p < rem ? 1 : 0);
+    begin = std::min(n, first * unit);
+    end = std::min(n, last * unit);
+}
+
+// Rejilla rows x cols = num_threads lo más cuadrada posible (rows >= cols)
+inline void thread_grid(int num_threads, int& rows, int& cols) {
+    cols = 1;
+    for (int c = 1; c * c <= num_threads; ++c) {
+        if (num_threads % c == 0) cols = c;
+    }
+    rows = num_threads / cols;
+}
+
+struct GemmThreadArgs {
+    ConstRealView A;
+    ConstRealView B;
+    RealView C;
+    size_t i0, i1, j0, j1;
+};
+
+inline void* gemm_thread(void* arg) {
+    GemmThreadArgs* args = static_cast<GemmThreadArgs*>(arg);
+    if (args->i0 >= args->i1 || args->j0 >= args->j1) return nullptr;
+
+    PackBuffers buf;  // paneles privados del hilo
+    matmul_packed_tile(args->A, args->B, args->C, args->i0, args->i1, args->j0, args->j1, buf);
+    return nullptr;
+}
+
+// C = A * B con num_threads hilos sobre tiles 2D de C
+inline void matmul_parallel(ConstRealView A, ConstRealView B, RealView C, int num_threads) {
+    C.fill(0.0);
+
+    int rows, cols;
+    thread_grid(num_threads, rows, cols);
+
+    std::vector<pthread_t> hilos(num_threads);
+    std::vector<GemmThreadArgs> args(num_threads);
+    const MicroKernel& uk = active_micro_kernel();
+
+    for (int t = 0; t < num_threads; ++t) {
+        GemmThreadArgs& a = args[t];
+        a.A = A;
+        a.B = B;
+        a.C = C;
+        // Filas en múltiplos de MR y columnas en múltiplos de NR: los tiles
+        // interiores nunca caen en el camino de borde del micro-kernel
+        split_range(C.rows(), rows, uk.mr, t / cols, a.i0, a.i1);
+        split_range(C.cols(), cols, uk.nr, t % cols, a.j0, a.j1);
+        pthread_create(&hilos[t], nullptr, gemm_thread, &a);
+    }
+
+    for (int t = 0; t < num_threads; ++t) {
+        pthread_join(hilos[t], nullptr);
+    }
+}
+
+// Tiles robables: WS_TILE_M filas (múltiplo de MC) y WS_TILE_N columnas
+// (múltiplo de todos los NR)
+constexpr size_t WS_TILE_M = 4 * MC, WS_TILE_N = 256;
+
+// C = A * B con num_threads hilos que se reparten tiles WS_TILE_M x WS_TILE_N de C
+// con robo de trabajo: si un hilo va más lento, los demás se llevan sus
+// tiles pendientes. Los tiles se numeran por columnas, así los de un mismo
+// trozo comparten columnas de B
+inline void matmul_work_stealing(ConstRealView A, ConstRealView B, RealView C, int num_threads,
+                                 WorkStealer& ws = default_stealer()) {
+    C.fill(0.0);
+
+    const size_t tiles_i = (C.rows() + WS_TILE_M - 1) / WS_TILE_M;
+    const size_t tiles_j = (C.cols() + WS_TILE_N - 1) / WS_TILE_N;
+    std::vector<PackBuffers> bufs(num_threads);  // uno por participante
+
+    ws.parallel_for(0, static_cast<long long>(tiles_i * tiles_j), num_threads, 1,
+                    [&](long long lo, long long hi, int id) {
+        for (long long t = lo; t < hi; ++t) {
+            const size_t i0 = (t % tiles_i) * WS_TILE_M, j0 = (t / tiles_i) * WS_TILE_N;
+            matmul_packed_tile(A, B, C, i0, std::min(i0 + WS_TILE_M, C.rows()),
+                               j0, std::min(j0 + WS_TILE_N, C.cols()), bufs[id]);
+        }
+    });
+}
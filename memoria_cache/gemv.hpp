@@ -0,0 +1,222 @@
+// GEMV (y = A * x) y GEMV por lotes / skinny GEMM (Y = A * X, X con k columnas).
+//
+// Un matvec lee A entera para producir un solo y: queda limitado por el ancho
+// de banda. Con k vectores a la vez cada fila de A se trae de memoria una vez
+// por lote y se reutiliza k veces desde caché/registros.
+//
+// X es n x k e Y es m x k, ambas row-major: la fila j de X son las k
+// componentes j de los vectores, contiguas, y el bucle interno sobre ellas
+// vectoriza.
+#pragma once
+
+#include <pthread.h>
+#include <algorithm>
+#include <vector>
+#include "gemm_paralelo.hpp"
+#include "../comun/cpu_dispatch.hpp"
+#if defined(ISA_X86)
+#include <immintrin.h>
+#endif
+
+// Filas de A procesadas juntas: cada X(j, :) cargado se usa GEMV_ROWS veces
+// y hay GEMV_ROWS acumuladores independientes para cubrir la latencia de FMA
+constexpr size_t GEMV_ROWS = 8;
+
+// ============================================
+// UN VECTOR
+// ============================================
+// y[i0, i1) = A[i0, i1) * x. El producto punto usa LANES acumuladores
+// independientes (un registro SIMD de double) para que el compilador lo
+// vectorice sin reasociar sumas. Cada variante ISA lo compila con su ancho.
+template <size_t LANES>
+ISA_INLINE void gemv_rows_body(ConstRealView A, const real* x, real* y, size_t i0, size_t i1) {
+    const size_t n = A.cols();
+    const size_t n_main = n / LANES * LANES;
+    for (size_t i = i0; i < i1; ++i) {
+        const real* a = &A(i, 0);
+        real acc[LANES] = {};
+        for (size_t j = 0; j < n_main; j += LANES)
+            for (size_t l = 0; l < LANES; ++l)
+                acc[l] += a[j + l] * x[j + l];
+        real sum = 0.0;
+        for (size_t l = 0; l < LANES; ++l) sum += acc[l];
+        for (size_t j = n_main; j < n; ++j) sum += a[j] * x[j];
+        y[i] = sum;
+    }
+}
+
+// ============================================
+// POR LOTES
+// ============================================
+// Y[rows x width] = A[rows x n] * X[n x width], con rows <= GEMV_ROWS y
+// width <= ancho del panel de la variante. a[q] apunta a la fila q de A; las
+// filas que faltan en el borde repiten la última y no se guardan.
+// Versión escalar: panel completo con ancho constante (el compilador lo
+// desenrolla) o resto; las variantes AVX usan cargas con máscara.
+template <size_t LANES>
+ISA_INLINE void gemv_batched_block_body(const real* const* a, size_t rows, size_t n,
+                                        const real* X, size_t ldx, real* Y, size_t ldy, size_t width) {
+    for (size_t q = 0; q < rows; ++q) {
+        real c[LANES] = {};
+        if (width == LANES) {
+            for (size_t j = 0; j < n; ++j)
+                for (size_t l = 0; l < LANES; ++l)
+                    c[l] += a[q][j] * X[j * ldx + l];
+        } else {
+            for (size_t j = 0; j < n; ++j)
+                for (size_t l = 0; l < width; ++l)
+                    c[l] += a[q][j] * X[j * ldx + l];
+        }
+        for (size_t l = 0; l < width; ++l)
+            Y[q * ldy + l] = c[l];
+    }
+}
+
+inline void gemv_rows_sse2(ConstRealView A, const real* x, real* y, size_t i0, size_t i1) {
+    gemv_rows_body<4>(A, x, y, i0, i1);
+}
+
+inline void gemv_batched_block_sse2(const real* const* a, size_t rows, size_t n,
+                                    const real* X, size_t ldx, real* Y, size_t ldy, size_t width) {
+    gemv_batched_block_body<4>(a, rows, n, X, ldx, Y, ldy, width);
+}
+
+#if defined(ISA_X86)
+ISA_TARGET_AVX2
+inline void gemv_rows_avx2(ConstRealView A, const real* x, real* y, size_t i0, size_t i1) {
+    gemv_rows_body<4>(A, x, y, i0, i1);
+}
+
+ISA_TARGET_AVX2
+inline void gemv_batched_block_avx2(const real* const* a, size_t rows, size_t n,
+                                    const real* X, size_t ldx, real* Y, size_t ldy, size_t width) {
+    const __m256i mask = _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(width)),
+                                            _mm256_set_epi64x(3, 2, 1, 0));
+    __m256d c[GEMV_ROWS];
+    for (size_t q = 0; q < GEMV_ROWS; ++q) c[q] = _mm256_setzero_pd();
+    for (size_t j = 0; j < n; ++j) {
+        __m256d x = _mm256_maskload_pd(X + j * ldx, mask);
+        for (size_t q = 0; q < GEMV_ROWS; ++q)
+            c[q] = _mm256_fmadd_pd(_mm256_broadcast_sd(a[q] + j), x, c[q]);
+    }
+    for (size_t q = 0; q < rows; ++q)
+        _mm256_maskstore_pd(Y + q * ldy, mask, c[q]);
+}
+
+ISA_TARGET_AVX512
+inline void gemv_rows_avx512(ConstRealView A, const real* x, real* y, size_t i0, size_t i1) {
+    gemv_rows_body<8>(A, x, y, i0, i1);
+}
+
+ISA_TARGET_AVX512
+inline void gemv_batched_block_avx512(const real* const* a, size_t rows, size_t n,
+                                      const real* X, size_t ldx, real* Y, size_t ldy, size_t width) {
+    const __mmask8 mask = static_cast<__mmask8>((1u << width) - 1);
+    __m512d c[GEMV_ROWS];
+    for (size_t q = 0; q < GEMV_ROWS; ++q) c[q] = _mm512_setzero_pd();
+    for (size_t j = 0; j < n; ++j) {
+        __m512d x = _mm512_maskz_loadu_pd(mask, X + j * ldx);
+        for (size_t q = 0; q < GEMV_ROWS; ++q)
+            c[q] = _mm512_fmadd_pd(_mm512_set1_pd(a[q][j]), x, c[q]);
+    }
+    for (size_t q = 0; q < rows; ++q)
+        _mm512_mask_storeu_pd(Y + q * ldy, mask, c[q]);
+}
+#endif
+
+// Kernels de la variante activa; lanes es el ancho del panel de X
+struct GemvKernels {
+    size_t lanes;
+    void (*rows)(ConstRealView A, const real* x, real* y, size_t i0, size_t i1);
+    void (*block)(const real* const* a, size_t rows, size_t n,
+                  const real* X, size_t ldx, real* Y, size_t ldy, size_t width);
+};
+
+inline GemvKernels gemv_kernels_for(Isa isa) {
+#if defined(ISA_X86)
+    if (isa == Isa::AVX512) return {8, gemv_rows_avx512, gemv_batched_block_avx512};
+    if (isa == Isa::AVX2) return {4, gemv_rows_avx2, gemv_batched_block_avx2};
+#endif
+    (void)isa;
+    return {4, gemv_rows_sse2, gemv_batched_block_sse2};
+}
+
+inline const GemvKernels& active_gemv_kernels() {
+    static const GemvKernels k = gemv_kernels_for(active_isa());
+    return k;
+}
+
+inline void gemv_rows(ConstRealView A, const real* x, real* y, size_t i0, size_t i1) {
+    active_gemv_kernels().rows(A, x, y, i0, i1);
+}
+
+inline void gemv(ConstRealView A, const real* x, real* y) {
+    gemv_rows(A, x, y, 0, A.rows());
+}
+
+// Y[i0, i1) = A[i0, i1) * X. Las GEMV_ROWS filas de A del bloque (unos KB)
+// quedan en L1/L2 mientras se recorren todos los paneles de X, así que A se
+// lee de memoria una sola vez. Con k = 1 se usa el camino de un vector.
+inline void gemv_batched_rows(ConstRealView A, ConstRealView X, RealView Y, size_t i0, size_t i1) {
+    const GemvKernels& kern = active_gemv_kernels();
+    const size_t k = X.cols();
+    if (k == 1 && X.ld() == 1 && Y.ld() == 1) {
+        kern.rows(A, X.data(), Y.data(), i0, i1);
+        return;
+    }
+    const real* a[GEMV_ROWS];
+    for (size_t i = i0; i < i1; i += GEMV_ROWS) {
+        size_t rows = std::min(GEMV_ROWS, i1 - i);
+        for (size_t q = 0; q < GEMV_ROWS; ++q) a[q] = &A(i + std::min(q, rows - 1), 0);
+        for (size_t r0 = 0; r0 < k; r0 += kern.lanes)
+            kern.block(a, rows, A.cols(), &X(0, r0), X.ld(), &Y(i, r0), Y.ld(),
+                       std::min(kern.lanes, k - r0));
+    }
+}
+
+inline void gemv_batched(ConstRealView A, ConstRealView X, RealView Y) {
+    gemv_batched_rows(A, X, Y, 0, A.rows());
+}
+
+// ============================================
+// MULTIHILO (filas repartidas entre hilos)
+// ============================================
+struct GemvThreadArgs {
+    ConstRealView A;
+    ConstRealView X;  // k = 1: x es la columna 0
+    RealView Y;
+    size_t i0, i1;
+};
+
+inline void* gemv_thread(void* arg) {
+    GemvThreadArgs* args = static_cast<GemvThreadArgs*>(arg);
+    gemv_batched_rows(args->A, args->X, args->Y, args->i0, args->i1);
+    return nullptr;
+}
+
+inline void gemv_launch(ConstRealView A, ConstRealView X, RealView Y, int num_threads) {
+    std::vector<pthread_t> hilos(num_threads);
+    std::vector<GemvThreadArgs> args(num_threads);
+
+    for (int t = 0; t < num_threads; ++t) {
+        GemvThreadArgs& a = args[t];
+        a.A = A;
+        a.X = X;
+        a.Y = Y;
+        split_range(A.rows(), num_threads, GEMV_ROWS, t, a.i0, a.i1);
+        pthread_create(&hilos[t], nullptr, gemv_thread, &a);
+    }
+    for (int t = 0; t < num_threads; ++t) {
+        pthread_join(hilos[t], nullptr);
+    }
+}
+
+// y = A * x con num_threads hilos
+inline void gemv_parallel(ConstRealView A, const real* x, real* y, int num_threads) {
+    gemv_launch(A, ConstRealView(x, A.cols(), 1, 1), RealView(y, A.rows(), 1, 1), num_threads);
+}
+
+// Y = A * X con num_threads hilos
+inline void gemv_batched_parallel(ConstRealView A, ConstRealView X, RealView Y, int num_threads) {
+    gemv_launch(A, X, Y, num_threads);
+}
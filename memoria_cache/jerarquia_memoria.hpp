@@ -0,0 +1,278 @@
+// Microbenchmarks de la jerarquía de memoria: latencia y ancho de banda por
+// nivel, alcance del TLB y detección de los escalones L1/L2/L3/DRAM.
+//
+// - Latencia: persecución de punteros sobre un ciclo aleatorio de líneas de
+//   caché. Cada carga depende de la anterior y el orden aleatorio anula al
+//   prefetcher, así que el tiempo por salto es la latencia del nivel donde
+//   cabe el conjunto de trabajo. El buffer pide páginas grandes para que los
+//   fallos de TLB no se mezclen con los de caché.
+// - Ancho de banda: lectura (suma) y escritura secuenciales por conjunto de
+//   trabajo y con paso fijo sobre un buffer mayor que la LLC, con 1..p hilos.
+// - TLB: un salto por página (páginas de 4 KB, sin páginas grandes) sobre
+//   cada vez más páginas; el escalón marca cuántas entradas cubre el TLB.
+// - Escalones: la curva latencia-tamaño se parte en mesetas; el final de
+//   cada meseta es la capacidad medida del nivel.
+#pragma once
+
+#include <pthread.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "matriz.hpp"
+#include "../comun/benchmark.hpp"
+#include "../comun/cpu_dispatch.hpp"
+
+// ============================================
+// MEMORIA
+// ============================================
+inline size_t page_size() {
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+// Memoria libre según el sistema (0 si no se puede saber)
+inline size_t available_memory() {
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    return pages > 0 ? static_cast<size_t>(pages) * page_size() : 0;
+}
+
+// Reserva `bytes` alineados a página grande; huge_pages pide (o prohíbe)
+// páginas grandes transparentes. Es un consejo: con THP desactivado en el
+// sistema el buffer queda en páginas de 4 KB igual.
+inline aligned_array<char> make_page_buffer(size_t bytes, bool huge_pages) {
+    bytes = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+    void* p = std::aligned_alloc(HUGE_PAGE, bytes);
+    if (!p) throw std::bad_alloc();
+#if defined(MADV_HUGEPAGE)
+    madvise(p, bytes, huge_pages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+#else
+    (void)huge_pages;
+#endif
+    return aligned_array<char>(static_cast<char*>(p));
+}
+
+// 4 KB, 6 KB, 8 KB, 12 KB, ... (potencias de 2 y sus puntos medios 1.5x)
+// hasta max_bytes
+inline std::vector<size_t> hierarchy_sizes(size_t min_bytes, size_t max_bytes) {
+    std::vector<size_t> sizes;
+    for (size_t s = min_bytes; s <= max_bytes; s *= 2) {
+        sizes.push_back(s);
+        if (s + s / 2 <= max_bytes) sizes.push_back(s + s / 2);
+    }
+    return sizes;
+}
+
+// ============================================
+// PERSECUCIÓN DE PUNTEROS
+// ============================================
+// Enlaza `count` ranuras de `base` (la ranura k está en base + offset(k)) en
+// un único ciclo de orden aleatorio y devuelve su primer elemento. Cada
+// ranura guarda en su primera palabra la dirección de la siguiente.
+template <typename Offset>
+void* build_chase_cycle(char* base, size_t count, Offset offset, uint64_t seed) {
+    std::vector<uint32_t> order(count);
+    std::iota(order.begin(), order.end(), 0u);
+    std::mt19937_64 rng(seed);
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t k = 0; k < count; ++k) {
+        char* from = base + offset(order[k]);
+        char* to = base + offset(order[(k + 1) % count]);
+        *reinterpret_cast<void**>(from) = to;
+    }
+    return base + offset(order[0]);
+}
+
+// `steps` cargas dependientes: ninguna puede empezar antes de la anterior
+inline void* chase_pointers(void* p, size_t steps) {
+    for (size_t s = 0; s < steps; ++s) p = *static_cast<void**>(p);
+    return p;
+}
+
+constexpr size_t CHASE_STEPS = size_t(1) << 21;
+
+// Nanosegundos por salto sobre el ciclo que empieza en `start`
+inline double measure_latency_ns(const std::string& name, void* start) {
+    void* p = start;
+    BenchStats st = run_benchmark(name, [&]() {
+        p = chase_pointers(p, CHASE_STEPS);
+        do_not_optimize(p);
+    });
+    return st.median / CHASE_STEPS * 1e9;
+}
+
+// Ciclo sobre las líneas de los primeros `bytes` del buffer
+inline void* line_chase_cycle(char* base, size_t bytes, size_t line) {
+    return build_chase_cycle(base, bytes / line, [line](size_t k) { return k * line; }, bytes);
+}
+
+// Ciclo de una línea por página sobre `pages` páginas. La línea dentro de
+// la página rota para que los datos se repartan en todos los conjuntos de
+// la caché y no choquen en uno solo.
+inline void* page_chase_cycle(char* base, size_t pages, size_t page, size_t line) {
+    const size_t lines_per_page = page / line;
+    return build_chase_cycle(base, pages, [=](size_t k) {
+        return k * page + (k % lines_per_page) * line;
+    }, pages);
+}
+
+// ============================================
+// ANCHO DE BANDA
+// ============================================
+// Lectura y escritura secuenciales: el compilador vectoriza los dos bucles
+// con el ancho de la variante ISA activa. La suma es entera para que la
+// reducción se pueda reordenar sin -ffast-math.
+ISA_INLINE void stream_read_body(const uint64_t* p, size_t n, uint64_t* out) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; ++i) sum += p[i];
+    *out = sum;
+}
+
+ISA_INLINE void stream_write_body(uint64_t* p, size_t n, uint64_t value) {
+    for (size_t i = 0; i < n; ++i) p[i] = value;
+}
+
+ISA_VARIANTS(stream_read, (const uint64_t* p, size_t n, uint64_t* out), (p, n, out))
+ISA_VARIANTS(stream_write, (uint64_t* p, size_t n, uint64_t value), (p, n, value))
+
+// Con paso: una palabra cada `step`; el costo lo pone la línea completa
+inline uint64_t strided_read(const uint64_t* p, size_t n, size_t step) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i += step) sum += p[i];
+    return sum;
+}
+
+inline void strided_write(uint64_t* p, size_t n, size_t step, uint64_t value) {
+    for (size_t i = 0; i < n; i += step) p[i] = value;
+}
+
+enum class StreamOp { Read, Write };
+
+inline const char* stream_op_name(StreamOp op) {
+    return op == StreamOp::Read ? "lectura" : "escritura";
+}
+
+struct StreamThreadArgs {
+    uint64_t* data;
+    size_t words;   // palabras de la región del hilo
+    size_t step;    // 1 = secuencial
+    int passes;     // recorridos de la región por medición
+    StreamOp op;
+    uint64_t sum;
+};
+
+inline void* stream_thread(void* arg) {
+    StreamThreadArgs* a = static_cast<StreamThreadArgs*>(arg);
+    for (int r = 0; r < a->passes; ++r) {
+        if (a->op == StreamOp::Read) {
+            uint64_t s;
+            if (a->step == 1) stream_read(a->data, a->words, &s);
+            else s = strided_read(a->data, a->words, a->step);
+            a->sum += s;
+        } else if (a->step == 1) {
+            stream_write(a->data, a->words, uint64_t(r));
+        } else {
+            strided_write(a->data, a->words, a->step, uint64_t(r));
+        }
+    }
+    return nullptr;
+}
+
+// Bytes mínimos que mueve cada hilo por medición, para que crear los hilos
+// no pese en los conjuntos de trabajo chicos
+constexpr size_t STREAM_MIN_BYTES = 64 * 1024 * 1024;
+
+struct BandwidthResult {
+    double seconds;        // mediana por medición
+    double useful_gbs;     // palabras pedidas por el kernel
+    double line_gbs;       // líneas que se traen o escriben completas
+};
+
+// Cada hilo recorre su propia región de `bytes_per_thread` bytes (consecutivas
+// en `base`, que debe tener num_threads * bytes_per_thread bytes)
+inline BandwidthResult measure_bandwidth(const std::string& name, char* base, size_t bytes_per_thread,
+                                         size_t stride, StreamOp op, int num_threads, size_t line) {
+    const size_t words = bytes_per_thread / sizeof(uint64_t);
+    const size_t step = std::max<size_t>(1, stride / sizeof(uint64_t));
+    const int passes = static_cast<int>(std::max<size_t>(1, STREAM_MIN_BYTES / bytes_per_thread));
+
+    std::vector<StreamThreadArgs> args(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+        uint64_t* region = reinterpret_cast<uint64_t*>(base + size_t(t) * bytes_per_thread);
+        args[t] = {region, words, step, passes, op, 0};
+    }
+    std::vector<pthread_t> hilos(num_threads);
+    BenchStats st = run_benchmark(name, [&]() {
+        if (num_threads == 1) {
+            stream_thread(&args[0]);
+        } else {
+            for (int t = 0; t < num_threads; ++t) pthread_create(&hilos[t], nullptr, stream_thread, &args[t]);
+            for (int t = 0; t < num_threads; ++t) pthread_join(hilos[t], nullptr);
+        }
+    });
+    for (const StreamThreadArgs& a : args) do_not_optimize(a.sum);
+
+    const double accesses = double((words + step - 1) / step) * passes * num_threads;
+    const double line_bytes = stride >= line ? accesses * line
+                                             : double(bytes_per_thread) * passes * num_threads;
+    return {st.median, accesses * sizeof(uint64_t) / st.median / 1e9, line_bytes / st.median / 1e9};
+}
+
+// ============================================
+// DETECCIÓN DE ESCALONES
+// ============================================
+struct CurvePoint {
+    size_t bytes;       // conjunto de trabajo (o páginas, en la prueba del TLB)
+    double latency_ns;
+};
+
+struct MemoryStep {
+    size_t capacity;    // último tamaño de la meseta; 0 = la curva termina en ella
+    double latency_ns;  // mediana de la meseta
+    size_t first, last; // índices de la meseta en la curva
+};
+
+// Parte la curva en mesetas: un punto sigue en la meseta mientras su
+// latencia no supere en más de `tolerance` a la del primero. Los puntos que
+// siguen subiendo más de `tolerance` respecto al anterior son transición, y
+// una meseta de menos de `min_points` puntos (una subida en dos tiempos)
+// también. La última meseta es la memoria principal (o la última que
+// alcanzó el barrido).
+//
+// La latencia no puede bajar al crecer el conjunto de trabajo: antes de
+// partir la curva, cada punto se recorta al mínimo de los siguientes para
+// que un pico aislado (una interrupción, otro proceso) no abra un nivel.
+inline std::vector<MemoryStep> detect_steps(const std::vector<CurvePoint>& curve,
+                                            double tolerance = 1.3, size_t min_points = 3) {
+    const size_t n = curve.size();
+    std::vector<double> lat(n);
+    for (size_t k = n; k-- > 0;)
+        lat[k] = k + 1 < n ? std::min(curve[k].latency_ns, lat[k + 1]) : curve[k].latency_ns;
+
+    std::vector<MemoryStep> steps;
+    size_t i = 0;
+    while (i < n) {
+        size_t j = i;
+        while (j + 1 < n && lat[j + 1] <= lat[i] * tolerance) ++j;
+        const bool last = j + 1 == n;
+        if (!last && !steps.empty() && j - i + 1 < min_points) {
+            i = j + 1;
+            continue;
+        }
+
+        std::vector<double> plateau;
+        for (size_t k = i; k <= j; ++k) plateau.push_back(curve[k].latency_ns);
+        std::nth_element(plateau.begin(), plateau.begin() + plateau.size() / 2, plateau.end());
+        steps.push_back({last ? 0 : curve[j].bytes, plateau[plateau.size() / 2], i, j});
+        if (last) break;
+
+        size_t k = j + 1;
+        while (k + 1 < n && lat[k + 1] > lat[k] * tolerance) ++k;
+        i = k;
+    }
+    return steps;
+}
@@ -0,0 +1,170 @@
+// Contenedor de matrices de memoria_cache/.
+//
+// Matrix<T, L> guarda los elementos en un único bloque contiguo alineado a
+// 64 bytes (una línea de caché), en orden row-major o column-major, con una
+// dimensión principal (ld) que puede ser mayor que la lógica para alinear
+// cada fila/columna. MatrixView<T, L> es una vista no propietaria (puntero,
+// filas, columnas, ld) que permite pasar submatrices sin copiar.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <type_traits>
+
+using real = double;
+
+#if defined(TRAZA_CACHE)
+// Build instrumentado: cada acceso a un elemento se envía al simulador de
+// caché (definido en simulador_cache.hpp, que el programa debe incluir)
+inline void trace_access(const void* address);
+#endif
+
+// Índice en arreglo aplanado row-major
+inline size_t idx(size_t i, size_t j, size_t N) { return i * N + j; }
+
+enum class Layout { RowMajor, ColMajor };
+
+// ============================================
+// MEMORIA ALINEADA
+// ============================================
+constexpr size_t CACHE_LINE = 64;
+constexpr size_t HUGE_PAGE = 2 * 1024 * 1024;  // página grande de x86-64
+
+struct FreeDeleter {
+    void operator()(void* p) const { std::free(p); }
+};
+
+template <typename T>
+using aligned_array = std::unique_ptr<T[], FreeDeleter>;
+
+// Reserva n elementos alineados a 64 bytes (sin inicializar)
+template <typename T>
+aligned_array<T> make_aligned_array(size_t n) {
+    static_assert(std::is_trivially_copyable_v<T>, "solo tipos triviales");
+    size_t bytes = std::max<size_t>(CACHE_LINE, ((n * sizeof(T) + CACHE_LINE - 1) / CACHE_LINE) * CACHE_LINE);
+    void* p = std::aligned_alloc(CACHE_LINE, bytes);
+    if (!p) throw std::bad_alloc();
+    return aligned_array<T>(static_cast<T*>(p));
+}
+
+// ============================================
+// VISTA NO PROPIETARIA
+// ============================================
+template <typename T, Layout L = Layout::RowMajor>
+class MatrixView {
+    T* data_ = nullptr;
+    size_t rows_ = 0, cols_ = 0, ld_ = 0;
+
+public:
+    MatrixView() = default;
+    MatrixView(T* data, size_t rows, size_t cols, size_t ld)
+        : data_(data), rows_(rows), cols_(cols), ld_(ld) {}
+    MatrixView(T* data, size_t rows, size_t cols)
+        : MatrixView(data, rows, cols, L == Layout::RowMajor ? cols : rows) {}
+
+    // Vista de solo lectura a partir de una mutable
+    operator MatrixView<const T, L>() const { return {data_, rows_, cols_, ld_}; }
+
+    size_t offset(size_t i, size_t j) const {
+        if constexpr (L == Layout::RowMajor) return i * ld_ + j;
+        else return j * ld_ + i;
+    }
+    T& operator()(size_t i, size_t j) const {
+#if defined(TRAZA_CACHE)
+        trace_access(data_ + offset(i, j));
+#endif
+        return data_[offset(i, j)];
+    }
+
+    T* data() const { return data_; }
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t ld() const { return ld_; }
+
+    // Submatriz de r x c que empieza en (i, j); comparte la memoria y el ld
+    MatrixView block(size_t i, size_t j, size_t r, size_t c) const {
+        return {data_ + offset(i, j), r, c, ld_};
+    }
+
+    void fill(std::remove_const_t<T> value) const {
+        constexpr bool row = L == Layout::RowMajor;
+        size_t outer = row ? rows_ : cols_, inner = row ? cols_ : rows_;
+        for (size_t o = 0; o < outer; ++o)
+            std::fill(data_ + o * ld_, data_ + o * ld_ + inner, value);
+    }
+};
+
+// ============================================
+// MATRIZ PROPIETARIA
+// ============================================
+template <typename T, Layout L = Layout::RowMajor>
+class Matrix {
+    aligned_array<T> data_;
+    size_t rows_ = 0, cols_ = 0, ld_ = 0;
+
+    size_t storage() const { return ld_ * (L == Layout::RowMajor ? rows_ : cols_); }
+
+public:
+    Matrix() = default;
+
+    // ld = 0 usa la dimensión lógica (filas contiguas sin relleno)
+    Matrix(size_t rows, size_t cols, size_t ld = 0)
+        : rows_(rows), cols_(cols),
+          ld_(ld ? ld : (L == Layout::RowMajor ? cols : rows)) {
+        data_ = make_aligned_array<T>(storage());
+        std::fill(data_.get(), data_.get() + storage(), T{});
+    }
+    explicit Matrix(size_t n) : Matrix(n, n) {}
+
+    Matrix(const Matrix& other) : Matrix(other.rows_, other.cols_, other.ld_) {
+        std::copy(other.data_.get(), other.data_.get() + storage(), data_.get());
+    }
+    Matrix& operator=(const Matrix& other) {
+        if (this != &other) *this = Matrix(other);
+        return *this;
+    }
+    Matrix(Matrix&&) noexcept = default;
+    Matrix& operator=(Matrix&&) noexcept = default;
+
+    MatrixView<T, L> view() { return {data_.get(), rows_, cols_, ld_}; }
+    MatrixView<const T, L> view() const { return {data_.get(), rows_, cols_, ld_}; }
+    operator MatrixView<T, L>() { return view(); }
+    operator MatrixView<const T, L>() const { return view(); }
+
+    T& operator()(size_t i, size_t j) { return view()(i, j); }
+    const T& operator()(size_t i, size_t j) const { return view()(i, j); }
+
+    T* data() { return data_.get(); }
+    const T* data() const { return data_.get(); }
+    size_t rows() const { return rows_; }
+    size_t cols() const { return cols_; }
+    size_t ld() const { return ld_; }
+
+    void fill(T value) { view().fill(value); }
+};
+
+// Valores uniformes en [lo, hi) recorriendo A por filas. Con T entero
+// (int8_t de la precisión mixta) la distribución es entera: la estándar no
+// admite tipos de un byte, así que se sortea en long long
+template <typename T, Layout L>
+void fill_uniform(MatrixView<T, L> A, std::mt19937_64& rng, T lo = 0, T hi = 1) {
+    if constexpr (std::is_integral_v<T>) {
+        std::uniform_int_distribution<long long> dist(lo, std::max<long long>(lo, hi - 1LL));
+        for (size_t i = 0; i < A.rows(); ++i)
+            for (size_t j = 0; j < A.cols(); ++j)
+                A(i, j) = static_cast<T>(dist(rng));
+    } else {
+        std::uniform_real_distribution<T> dist(lo, hi);
+        for (size_t i = 0; i < A.rows(); ++i)
+            for (size_t j = 0; j < A.cols(); ++j)
+                A(i, j) = dist(rng);
+    }
+}
+
+// Vistas row-major de reales, las que reciben los kernels
+using RealView = MatrixView<real>;
+using ConstRealView = MatrixView<const real>;
@@ -0,0 +1,27 @@
+// Los dos órdenes de bucles de y += A * x de 1_bucles_anidados.
+//
+// Por filas (i externo) recorre A en el orden en que está guardada si es
+// row-major; por columnas (j externo) salta ld elementos en cada acceso. Sin
+// bloques ni SIMD a propósito: son la referencia que miden 1_bucles_anidados,
+// el roofline (10) y el simulador de caché (11, con los accesos trazados).
+//
+// View es cualquier tipo con A(i, j), rows() y cols(): MatrixView row-major o
+// col-major, o el arreglo global de 1_bucles_anidados.
+#pragma once
+
+#include <cstddef>
+#include "matriz.hpp"
+
+template <typename View>
+void matvec_by_rows(const View& A, const real* x, real* y) {
+    for (size_t i = 0; i < A.rows(); i++)
+        for (size_t j = 0; j < A.cols(); j++)
+            y[i] += A(i, j) * x[j];
+}
+
+template <typename View>
+void matvec_by_columns(const View& A, const real* x, real* y) {
+    for (size_t j = 0; j < A.cols(); j++)
+        for (size_t i = 0; i < A.rows(); i++)
+            y[i] += A(i, j) * x[j];
+}
@@ -0,0 +1,128 @@
+// Layout Morton (Z-order) por tiles y multiplicación recursiva
+// cache-oblivious sobre ese layout.
+//
+// La matriz N x N se rellena con ceros hasta P = T * 2^L y se parte en
+// 2^L x 2^L tiles de T x T (cada tile row-major). Los tiles se guardan en
+// orden Z: los cuatro cuadrantes de cualquier bloque de 2^l x 2^l tiles
+// quedan contiguos (11, 12, 21, 22), así que cada nivel de la recursión
+// trabaja sobre memoria contigua y, a partir del nivel que cabe en una caché,
+// todo el subproblema queda en ella sin conocer su tamaño.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "matriz.hpp"
+#include "../comun/cpu_dispatch.hpp"
+
+// T está en (MORTON_MAX_TILE/2, MORTON_MAX_TILE] y solo amortiza el costo de
+// la recursión; no depende de la caché y no se ajusta.
+constexpr size_t MORTON_MAX_TILE = 32;
+
+// Intercala los bits de (ti, tj): ti en posiciones impares, tj en pares
+inline size_t morton_index(size_t ti, size_t tj) {
+    size_t z = 0;
+    for (size_t b = 0; (ti >> b) || (tj >> b); ++b) {
+        z |= ((tj >> b) & 1) << (2 * b);
+        z |= ((ti >> b) & 1) << (2 * b + 1);
+    }
+    return z;
+}
+
+struct MortonMatrix {
+    size_t n = 0;       // dimensión lógica
+    size_t tile = 0;    // T
+    size_t levels = 0;  // L: 2^L tiles por lado
+    aligned_array<real> data;
+
+    MortonMatrix() = default;
+    explicit MortonMatrix(size_t n_) : n(n_) {
+        // Menor L con ceil(n / 2^L) <= MORTON_MAX_TILE. T se redondea a
+        // múltiplo de 4 para que el bucle interno de la hoja vectorice sin
+        // resto; el relleno queda por debajo de 4 * 2^L filas/columnas.
+        while ((n + (size_t(1) << levels) - 1) >> levels > MORTON_MAX_TILE) ++levels;
+        tile = (((n + (size_t(1) << levels) - 1) >> levels) + 3) / 4 * 4;
+        data = make_aligned_array<real>(size());
+        std::fill(data.get(), data.get() + size(), 0.0);
+    }
+
+    size_t tiles_per_side() const { return size_t(1) << levels; }
+    size_t padded() const { return tile * tiles_per_side(); }
+    size_t size() const { return padded() * padded(); }
+
+    // Posición del elemento (i, j) dentro de data
+    size_t offset(size_t i, size_t j) const {
+        size_t t = morton_index(i / tile, j / tile);
+        return t * tile * tile + (i % tile) * tile + (j % tile);
+    }
+};
+
+// Row-major -> Morton (el relleno queda en cero)
+inline void to_morton(ConstRealView src, MortonMatrix& dst) {
+    const size_t T = dst.tile;
+    for (size_t ti = 0; ti * T < src.rows(); ++ti) {
+        for (size_t tj = 0; tj * T < src.cols(); ++tj) {
+            real* tile = dst.data.get() + morton_index(ti, tj) * T * T;
+            size_t rows = std::min(T, src.rows() - ti * T);
+            size_t cols = std::min(T, src.cols() - tj * T);
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < cols; ++j)
+                    tile[i * T + j] = src(ti * T + i, tj * T + j);
+        }
+    }
+}
+
+// Morton -> row-major (se descarta el relleno)
+inline void from_morton(const MortonMatrix& src, RealView dst) {
+    const size_t T = src.tile;
+    for (size_t ti = 0; ti * T < dst.rows(); ++ti) {
+        for (size_t tj = 0; tj * T < dst.cols(); ++tj) {
+            const real* tile = src.data.get() + morton_index(ti, tj) * T * T;
+            size_t rows = std::min(T, dst.rows() - ti * T);
+            size_t cols = std::min(T, dst.cols() - tj * T);
+            for (size_t i = 0; i < rows; ++i)
+                for (size_t j = 0; j < cols; ++j)
+                    dst(ti * T + i, tj * T + j) = tile[i * T + j];
+        }
+    }
+}
+
+// C += A * B para un tile T x T (orden ikj: el bucle interno es contiguo),
+// en las tres variantes ISA de cpu_dispatch.hpp
+ISA_INLINE void morton_leaf_body(const real* A, const real* B, real* C, size_t T) {
+    for (size_t i = 0; i < T; ++i) {
+        for (size_t k = 0; k < T; ++k) {
+            real a = A[i * T + k];
+            for (size_t j = 0; j < T; ++j) {
+                C[i * T + j] += a * B[k * T + j];
+            }
+        }
+    }
+}
+ISA_VARIANTS(morton_leaf, (const real* A, const real* B, real* C, size_t T), (A, B, C, T))
+
+// C += A * B sobre bloques contiguos de 4^level tiles en orden Z
+inline void morton_rec(const real* A, const real* B, real* C, size_t level, size_t T) {
+    if (level == 0) {
+        morton_leaf(A, B, C, T);
+        return;
+    }
+    const size_t q = (size_t(1) << (2 * (level - 1))) * T * T;  // elementos por cuadrante
+    const real *A11 = A, *A12 = A + q, *A21 = A + 2 * q, *A22 = A + 3 * q;
+    const real *B11 = B, *B12 = B + q, *B21 = B + 2 * q, *B22 = B + 3 * q;
+    real *C11 = C, *C12 = C + q, *C21 = C + 2 * q, *C22 = C + 3 * q;
+
+    morton_rec(A11, B11, C11, level - 1, T);
+    morton_rec(A12, B21, C11, level - 1, T);
+    morton_rec(A11, B12, C12, level - 1, T);
+    morton_rec(A12, B22, C12, level - 1, T);
+    morton_rec(A21, B11, C21, level - 1, T);
+    morton_rec(A22, B21, C21, level - 1, T);
+    morton_rec(A21, B12, C22, level - 1, T);
+    morton_rec(A22, B22, C22, level - 1, T);
+}
+
+// C = A * B; las tres deben tener el mismo n (y por lo tanto el mismo T y L)
+inline void matmul_morton(const MortonMatrix& A, const MortonMatrix& B, MortonMatrix& C) {
+    std::fill(C.data.get(), C.data.get() + C.size(), 0.0);
+    morton_rec(A.data.get(), B.data.get(), C.data.get(), C.levels, C.tile);
+}
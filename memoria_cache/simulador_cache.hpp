@@ -0,0 +1,370 @@
+// Simulador de jerarquía de caché alimentado por la traza de direcciones de
+// los kernels.
+//
+// Con TRAZA_CACHE definida antes de incluir matriz.hpp, cada acceso a un
+// elemento por MatrixView::operator() llama a trace_access() con su
+// dirección; si hay un simulador activo (TraceRegion) el acceso se cuenta en
+// la región actual. Los kernels son los mismos de siempre, solo cambia el
+// build, y lo que no pasa por una vista (pack_*, fill) no se traza.
+//
+// Cada nivel es asociativo por conjuntos, con el mismo tamaño de línea en
+// toda la jerarquía y reemplazo LRU o pseudo-LRU (bits MRU: un bit por vía,
+// la víctima es la primera vía sin marcar). Los niveles no son inclusivos:
+// un fallo asigna la línea en cada nivel que la pidió y los desalojos no se
+// propagan.
+//
+// Un acierto en la línea más reciente de su conjunto de L1 se resuelve en
+// access() con una carga y una comparación; el resto recorre L1 y solo si
+// falla los niveles de abajo, compilado en las variantes de cpu_dispatch.hpp.
+//
+// Un L3 grande se simula sobre una muestra de sus conjuntos (ver
+// SIM_MAX_SAMPLED_SETS): sus tasas y fallos son estimaciones; L1 y L2 son
+// exactos.
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "cpu_info.hpp"
+#include "../comun/cpu_dispatch.hpp"
+
+enum class Replacement { LRU, PLRU };
+
+inline const char* replacement_name(Replacement r) {
+    return r == Replacement::LRU ? "LRU" : "PLRU";
+}
+
+// ============================================
+// UN NIVEL
+// ============================================
+enum class Lookup { Hit, Miss, Unsampled };
+
+class SetAssociativeCache {
+    static constexpr uint64_t EMPTY = ~uint64_t(0);
+    static constexpr uint32_t NOT_SAMPLED = ~uint32_t(0);
+
+    size_t sets_, ways_;
+    size_t set_mask_;  // sets_ - 1 si es potencia de 2, 0 si no
+    size_t sample_;    // 1: todos los conjuntos; k: uno de cada k
+    Replacement policy_;
+    // Un bloque por conjunto simulado:
+    //   LRU: las etiquetas de la más a la menos reciente (mover al frente);
+    //        la víctima es la última y no hace falta guardar instantes
+    //   PLRU: [etiquetas (ways) | un bit "usada recientemente" por vía |
+    //         vía MRU]; la víctima es la primera vía sin marcar
+    // El bloque ocupa un número impar de palabras: con un paso potencia de 2
+    // los conjuntos que visita un recorrido por columnas caerían en el mismo
+    // conjunto de la caché real y el simulador sufriría el mismo aliasing
+    // que está midiendo.
+    size_t bits_, mru_, stride_;
+    std::vector<uint64_t> data_;
+    std::vector<uint32_t> slot_;  // conjunto -> bloque (con muestreo)
+
+    size_t set_of(uint64_t line) const {
+        return set_mask_ ? (line & set_mask_) : (line % sets_);
+    }
+
+    // Con muestreo se simula un conjunto de cada sample_, elegidos con un
+    // hash del índice: un recorrido con paso fijo visita conjuntos en
+    // progresión aritmética y un criterio por módulo los tomaría todos o
+    // ninguno
+    bool sampled(size_t set) const {
+        return ((uint64_t(set) + 1) * 0x9E3779B97F4A7C15ull >> 40) % sample_ == 0;
+    }
+
+    // Vía que contiene la línea o ways_. Sin saltos que dependan de dónde
+    // está: el compilador vectoriza la comparación con el ancho de la
+    // variante de cpu_dispatch.hpp que la incluye
+    ISA_INLINE size_t find(const uint64_t* tags, uint64_t line) const {
+        uint64_t found = 0;
+        for (size_t w = 0; w < ways_; ++w) found |= uint64_t(tags[w] == line) << w;
+        return found ? static_cast<size_t>(__builtin_ctzll(found)) : ways_;
+    }
+
+    // Una sola pasada: cada etiqueta baja un lugar hasta encontrar la línea
+    // (acierto) o caerse la última (fallo); la línea queda al frente
+    ISA_INLINE static bool access_lru(uint64_t* tags, size_t ways, uint64_t line) {
+        uint64_t carry = line;
+        for (size_t w = 0; w < ways; ++w) {
+            const uint64_t t = tags[w];
+            tags[w] = carry;
+            if (t == line) return true;
+            carry = t;
+        }
+        return false;
+    }
+
+    ISA_INLINE bool access_plru(uint64_t* block, uint64_t line) {
+        size_t w = block[mru_];
+        if (block[w] == line) return true;  // su bit ya está marcado
+        w = find(block, line);
+        const bool hit = w < ways_;
+        if (!hit) {
+            w = static_cast<size_t>(__builtin_ctzll(~block[bits_]));
+            block[w] = line;
+        }
+        block[mru_] = w;
+        uint64_t& bits = block[bits_];
+        bits |= uint64_t(1) << w;
+        // Todas marcadas: se reinicia dejando solo la recién usada
+        if (bits == (ways_ == 64 ? EMPTY : (uint64_t(1) << ways_) - 1)) bits = uint64_t(1) << w;
+        return hit;
+    }
+
+public:
+    // sample: simular uno de cada `sample` conjuntos (1 = todos)
+    SetAssociativeCache(size_t size, size_t line_size, size_t ways, Replacement policy, size_t sample = 1)
+        : ways_(ways), sample_(sample ? sample : 1), policy_(policy) {
+        if (ways_ == 0 || ways_ > 64 || line_size == 0 || size < line_size * ways_)
+            throw std::invalid_argument("geometría de caché inválida");
+        sets_ = size / (line_size * ways_);
+        set_mask_ = sets_ > 1 && (sets_ & (sets_ - 1)) == 0 ? sets_ - 1 : 0;
+        bits_ = ways_;
+        mru_ = ways_ + 1;
+        stride_ = (policy_ == Replacement::LRU ? ways_ : mru_ + 1) | 1;
+
+        size_t blocks = sets_;
+        if (sample_ > 1) {
+            slot_.assign(sets_, NOT_SAMPLED);
+            blocks = 0;
+            for (size_t s = 0; s < sets_; ++s)
+                if (sampled(s)) slot_[s] = static_cast<uint32_t>(blocks++);
+        }
+        data_.resize(blocks * stride_);
+        flush();
+    }
+
+    size_t sets() const { return sets_; }
+    size_t ways() const { return ways_; }
+    size_t sample() const { return sample_; }
+
+    // La línea es la más reciente de su conjunto: accederla sería un
+    // acierto que no cambia el estado. Solo sin muestreo (L1)
+    bool is_mru(uint64_t line) const {
+        const uint64_t* block = &data_[set_of(line) * stride_];
+        return block[policy_ == Replacement::LRU ? 0 : block[mru_]] == line;
+    }
+
+    // Hit si la línea estaba; Miss si no, y queda cargada; Unsampled si su
+    // conjunto no se simula
+    ISA_INLINE Lookup access(uint64_t line) {
+        size_t block = set_of(line);
+        if (sample_ > 1) {
+            block = slot_[block];
+            if (block == NOT_SAMPLED) return Lookup::Unsampled;
+        }
+        uint64_t* tags = &data_[block * stride_];
+        // La más reciente del conjunto: acierto sin cambiar el estado
+        if (tags[0] == line && policy_ == Replacement::LRU) return Lookup::Hit;
+        const bool hit = policy_ == Replacement::LRU ? access_lru(tags, ways_, line) : access_plru(tags, line);
+        return hit ? Lookup::Hit : Lookup::Miss;
+    }
+
+    void flush() {
+        for (size_t b = 0; b < data_.size(); b += stride_) {
+            std::fill(&data_[b], &data_[b] + ways_, EMPTY);
+            std::fill(&data_[b] + ways_, &data_[b] + stride_, 0);
+        }
+    }
+};
+
+// ============================================
+// JERARQUÍA
+// ============================================
+// Conjuntos que se simulan como máximo en el último nivel: un L3 de decenas
+// de MB tiene cientos de miles y cada fallo de L2 caería en uno distinto.
+// Más allá se simula una muestra de conjuntos (set sampling) y los fallos
+// del nivel se extrapolan
+constexpr size_t SIM_MAX_SAMPLED_SETS = 8192;
+
+// Aciertos y fallos de cada nivel en una región (un nido de bucles)
+struct CacheRegionStats {
+    std::string name;
+    uint64_t accesses = 0;
+    // unsampled: accesos que cayeron en conjuntos no simulados
+    std::vector<uint64_t> hits, misses, unsampled;
+
+    // Sobre los accesos simulados: con muestreo es la estimación de la tasa
+    double miss_rate(size_t level) const {
+        uint64_t total = hits[level] + misses[level];
+        return total ? double(misses[level]) / total : 0.0;
+    }
+
+    // Fallos contados, o extrapolados a todos los accesos si el nivel se
+    // simuló con muestreo
+    double estimated_misses(size_t level) const {
+        return misses[level] + miss_rate(level) * unsampled[level];
+    }
+};
+
+class CacheSimulator {
+    static constexpr size_t MAX_LEVELS = 4;
+
+    std::vector<CacheLevel> config_;
+    Replacement policy_;
+    unsigned line_shift_ = 0;
+    // L1 aparte: es el único nivel que ve todos los accesos
+    SetAssociativeCache l1_;
+    std::vector<SetAssociativeCache> lower_;  // L2, L3, ...
+    uint64_t last_line_ = ~uint64_t(0);
+    std::vector<CacheRegionStats> regions_;
+    size_t current_ = 0;
+    bool active_ = false;
+    // Contadores de la región en curso; se suman a regions_ en end_region()
+    uint64_t accesses_ = 0;
+    uint64_t hits_[MAX_LEVELS] = {}, misses_[MAX_LEVELS] = {}, unsampled_[MAX_LEVELS] = {};
+
+    static unsigned line_shift(const std::vector<CacheLevel>& config) {
+        if (config.empty() || config.size() > MAX_LEVELS)
+            throw std::invalid_argument("la jerarquía debe tener entre 1 y 4 niveles");
+        size_t line = config[0].line_size;
+        if (line == 0 || (line & (line - 1)) != 0)
+            throw std::invalid_argument("el tamaño de línea debe ser potencia de 2");
+        for (const CacheLevel& c : config)
+            if (c.line_size != line) throw std::invalid_argument("todos los niveles usan la misma línea");
+        return static_cast<unsigned>(__builtin_ctzll(line));
+    }
+
+    // El último nivel se simula con muestreo si tiene más de
+    // SIM_MAX_SAMPLED_SETS conjuntos (L1 nunca)
+    static SetAssociativeCache make_level(const std::vector<CacheLevel>& config, size_t l, Replacement policy) {
+        const CacheLevel& c = config[l];
+        const size_t sets = c.ways ? c.size / (c.line_size * c.ways) : 0;
+        const size_t sample =
+            l + 1 == config.size() && l > 0 ? (sets + SIM_MAX_SAMPLED_SETS - 1) / SIM_MAX_SAMPLED_SETS : 1;
+        return SetAssociativeCache(c.size, c.line_size, c.ways, policy, sample);
+    }
+
+    // Un acceso que no resolvieron los filtros de access(): L1 y, solo si
+    // falla, los niveles de abajo hasta el primero que tenga la línea
+    ISA_INLINE void walk(uint64_t line) {
+        if (l1_.access(line) == Lookup::Hit) {
+            ++hits_[0];
+            return;
+        }
+        ++misses_[0];
+        for (size_t l = 0; l < lower_.size(); ++l) {
+            switch (lower_[l].access(line)) {
+                case Lookup::Hit: ++hits_[l + 1]; return;
+                case Lookup::Miss: ++misses_[l + 1]; break;
+                case Lookup::Unsampled: ++unsampled_[l + 1]; return;
+            }
+        }
+    }
+    friend void cache_walk_body(CacheSimulator& sim, uint64_t line);
+
+public:
+    // Todos los niveles deben usar el mismo tamaño de línea (potencia de 2)
+    CacheSimulator(const std::vector<CacheLevel>& config, Replacement policy)
+        : config_(config), policy_(policy), line_shift_(line_shift(config)),
+          l1_(make_level(config, 0, policy)) {
+        for (size_t l = 1; l < config.size(); ++l) lower_.push_back(make_level(config, l, policy));
+    }
+
+    const std::vector<CacheLevel>& config() const { return config_; }
+    Replacement policy() const { return policy_; }
+    size_t line_size() const { return size_t(1) << line_shift_; }
+    // 1 si el nivel se simula entero; k si se simula uno de cada k conjuntos
+    size_t sample(size_t level) const { return level == 0 ? l1_.sample() : lower_[level - 1].sample(); }
+    const std::vector<CacheRegionStats>& regions() const { return regions_; }
+
+    // Cuenta los accesos siguientes en la región `name` (se acumulan si ya existe)
+    void begin_region(const std::string& name) {
+        if (active_) end_region();
+        current_ = 0;
+        while (current_ < regions_.size() && regions_[current_].name != name) ++current_;
+        if (current_ == regions_.size()) {
+            CacheRegionStats r;
+            r.name = name;
+            r.hits.assign(config_.size(), 0);
+            r.misses.assign(config_.size(), 0);
+            r.unsampled.assign(config_.size(), 0);
+            regions_.push_back(std::move(r));
+        }
+        active_ = true;
+    }
+
+    void end_region() {
+        if (!active_) return;
+        CacheRegionStats& r = regions_[current_];
+        r.accesses += accesses_;
+        accesses_ = 0;
+        for (size_t l = 0; l < config_.size(); ++l) {
+            r.hits[l] += hits_[l];
+            r.misses[l] += misses_[l];
+            r.unsampled[l] += unsampled_[l];
+            hits_[l] = misses_[l] = unsampled_[l] = 0;
+        }
+        active_ = false;
+    }
+
+    // Vacía todos los niveles (para medir cada kernel en frío)
+    void flush() {
+        l1_.flush();
+        for (SetAssociativeCache& level : lower_) level.flush();
+        last_line_ = ~uint64_t(0);
+    }
+
+    void access(const void* address);
+};
+
+// walk() en las variantes de cpu_dispatch.hpp: la búsqueda de etiquetas de
+// PLRU usa el vector más ancho de la CPU
+ISA_INLINE void cache_walk_body(CacheSimulator& sim, uint64_t line) {
+    sim.walk(line);
+}
+ISA_VARIANTS(cache_walk, (CacheSimulator& sim, uint64_t line), (sim, line))
+
+// Se inserta en cada acceso del kernel: resuelve sin llamar a walk() los
+// aciertos en la línea más reciente de su conjunto de L1
+inline void CacheSimulator::access(const void* address) {
+    uint64_t line = reinterpret_cast<uintptr_t>(address) >> line_shift_;
+    ++accesses_;
+    // Misma línea que el acceso anterior: ya es la más reciente de su
+    // conjunto en L1, acierto sin cambiar el estado (exacto con LRU y PLRU)
+    if (line == last_line_) {
+        ++hits_[0];
+        return;
+    }
+    last_line_ = line;
+    // La más reciente de su conjunto (p.ej. la de otro flujo intercalado,
+    // A(i,k) con B(k,j)): tampoco cambia el estado
+    if (l1_.is_mru(line)) {
+        ++hits_[0];
+        return;
+    }
+    cache_walk(*this, line);
+}
+
+// ============================================
+// ENGANCHE CON LOS KERNELS
+// ============================================
+// Simulador que recibe los accesos del hilo; nullptr fuera de una
+// TraceRegion. Uno por hilo: cada hilo puede simular un nido distinto
+inline thread_local CacheSimulator* active_cache_simulator = nullptr;
+
+inline void trace_access(const void* address) {
+    if (active_cache_simulator) active_cache_simulator->access(address);
+}
+
+// Activa el simulador para una región mientras vive el objeto; con
+// cold = true vacía las cachés antes de empezar
+class TraceRegion {
+    CacheSimulator& sim_;
+public:
+    TraceRegion(CacheSimulator& sim, const std::string& name, bool cold = true) : sim_(sim) {
+        if (cold) sim_.flush();
+        sim_.begin_region(name);
+        active_cache_simulator = &sim_;
+    }
+    ~TraceRegion() {
+        active_cache_simulator = nullptr;
+        sim_.end_region();
+    }
+    TraceRegion(const TraceRegion&) = delete;
+    TraceRegion& operator=(const TraceRegion&) = delete;
+};
@@ -0,0 +1,385 @@
+// Matrices dispersas y producto matriz-vector disperso (SpMV) y = A * x.
+//
+// Formatos:
+//   - COO: tripletas (fila, columna, valor); formato de construcción
+//   - CSR: filas comprimidas (row_ptr, col, val)
+//   - ELL: ancho fijo = máximo de no-ceros por fila, guardado por columnas
+//   - SELL-C-σ: ELL por trozos de C filas, con las filas ordenadas por
+//     longitud dentro de ventanas de σ filas para reducir el relleno
+#pragma once
+
+#include <pthread.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "matriz.hpp"
+#include "../comun/cpu_dispatch.hpp"
+#if defined(ISA_X86)
+#include <immintrin.h>
+#endif
+
+using index_t = uint32_t;
+
+struct CooMatrix {
+    size_t rows = 0, cols = 0;
+    std::vector<index_t> row, col;
+    std::vector<real> val;
+
+    void add(index_t i, index_t j, real v) {
+        row.push_back(i);
+        col.push_back(j);
+        val.push_back(v);
+    }
+};
+
+struct CsrMatrix {
+    size_t rows = 0, cols = 0;
+    std::vector<size_t> row_ptr;  // rows + 1
+    std::vector<index_t> col;
+    std::vector<real> val;
+
+    size_t nnz() const { return val.size(); }
+};
+
+struct EllMatrix {
+    size_t rows = 0, cols = 0, width = 0;
+    std::vector<index_t> col;  // width x rows, column-major
+    std::vector<real> val;     // relleno: val = 0, col = 0
+};
+
+struct SellMatrix {
+    size_t rows = 0, cols = 0, chunk = 0, sigma = 0;
+    std::vector<index_t> perm;        // fila original de cada fila ordenada
+    std::vector<size_t> chunk_ptr;    // inicio de cada trozo en col/val
+    std::vector<index_t> chunk_width; // ancho de cada trozo
+    std::vector<index_t> col;         // por trozo: width x chunk, column-major
+    std::vector<real> val;
+};
+
+// ============================================
+// CONVERSIONES
+// ============================================
+// COO -> CSR: conteo por fila, orden por columna dentro de cada fila y suma
+// de las entradas repetidas
+inline CsrMatrix coo_to_csr(const CooMatrix& coo) {
+    CsrMatrix csr;
+    csr.rows = coo.rows;
+    csr.cols = coo.cols;
+    csr.row_ptr.assign(coo.rows + 1, 0);
+    for (index_t i : coo.row) csr.row_ptr[i + 1]++;
+    std::partial_sum(csr.row_ptr.begin(), csr.row_ptr.end(), csr.row_ptr.begin());
+
+    std::vector<index_t> col(coo.val.size());
+    std::vector<real> val(coo.val.size());
+    std::vector<size_t> next(csr.row_ptr.begin(), csr.row_ptr.end() - 1);
+    for (size_t e = 0; e < coo.val.size(); ++e) {
+        size_t pos = next[coo.row[e]]++;
+        col[pos] = coo.col[e];
+        val[pos] = coo.val[e];
+    }
+
+    csr.col.reserve(col.size());
+    csr.val.reserve(val.size());
+    std::vector<size_t> order;
+    size_t written = 0;
+    for (size_t i = 0; i < csr.rows; ++i) {
+        size_t begin = csr.row_ptr[i], end = csr.row_ptr[i + 1];
+        order.resize(end - begin);
+        std::iota(order.begin(), order.end(), begin);
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return col[a] < col[b]; });
+        csr.row_ptr[i] = written;
+        for (size_t e : order) {
+            if (written > csr.row_ptr[i] && csr.col.back() == col[e]) {
+                csr.val.back() += val[e];
+            } else {
+                csr.col.push_back(col[e]);
+                csr.val.push_back(val[e]);
+                ++written;
+            }
+        }
+    }
+    csr.row_ptr[csr.rows] = written;
+    return csr;
+}
+
+inline EllMatrix csr_to_ell(const CsrMatrix& csr) {
+    EllMatrix ell;
+    ell.rows = csr.rows;
+    ell.cols = csr.cols;
+    for (size_t i = 0; i < csr.rows; ++i)
+        ell.width = std::max(ell.width, csr.row_ptr[i + 1] - csr.row_ptr[i]);
+    ell.col.assign(ell.width * ell.rows, 0);
+    ell.val.assign(ell.width * ell.rows, 0.0);
+    for (size_t i = 0; i < csr.rows; ++i) {
+        for (size_t e = csr.row_ptr[i], k = 0; e < csr.row_ptr[i + 1]; ++e, ++k) {
+            ell.col[k * ell.rows + i] = csr.col[e];
+            ell.val[k * ell.rows + i] = csr.val[e];
+        }
+    }
+    return ell;
+}
+
+inline SellMatrix csr_to_sell(const CsrMatrix& csr, size_t chunk, size_t sigma) {
+    SellMatrix sell;
+    sell.rows = csr.rows;
+    sell.cols = csr.cols;
+    sell.chunk = chunk;
+    sell.sigma = sigma;
+
+    auto row_len = [&](index_t i) { return csr.row_ptr[i + 1] - csr.row_ptr[i]; };
+
+    // Orden descendente por longitud dentro de cada ventana de sigma filas
+    sell.perm.resize(csr.rows);
+    std::iota(sell.perm.begin(), sell.perm.end(), 0);
+    for (size_t w = 0; w < csr.rows; w += sigma) {
+        auto first = sell.perm.begin() + w;
+        auto last = sell.perm.begin() + std::min(w + sigma, csr.rows);
+        std::stable_sort(first, last, [&](index_t a, index_t b) { return row_len(a) > row_len(b); });
+    }
+
+    size_t num_chunks = (csr.rows + chunk - 1) / chunk;
+    sell.chunk_ptr.assign(num_chunks + 1, 0);
+    sell.chunk_width.assign(num_chunks, 0);
+    for (size_t c = 0; c < num_chunks; ++c) {
+        size_t width = 0;
+        for (size_t r = c * chunk; r < std::min((c + 1) * chunk, csr.rows); ++r)
+            width = std::max(width, row_len(sell.perm[r]));
+        sell.chunk_width[c] = static_cast<index_t>(width);
+        sell.chunk_ptr[c + 1] = sell.chunk_ptr[c] + width * chunk;
+    }
+
+    sell.col.assign(sell.chunk_ptr[num_chunks], 0);
+    sell.val.assign(sell.chunk_ptr[num_chunks], 0.0);
+    for (size_t c = 0; c < num_chunks; ++c) {
+        for (size_t r = 0; r < chunk && c * chunk + r < csr.rows; ++r) {
+            index_t i = sell.perm[c * chunk + r];
+            for (size_t e = csr.row_ptr[i], k = 0; e < csr.row_ptr[i + 1]; ++e, ++k) {
+                sell.col[sell.chunk_ptr[c] + k * chunk + r] = csr.col[e];
+                sell.val[sell.chunk_ptr[c] + k * chunk + r] = csr.val[e];
+            }
+        }
+    }
+    return sell;
+}
+
+// ============================================
+// GENERADORES
+// ============================================
+// Matriz de banda: cada fila i tiene no-ceros en [i - half_width, i + half_width]
+inline CooMatrix generate_banded(size_t n, size_t half_width, std::mt19937_64& rng) {
+    std::uniform_real_distribution<real> dist(-1.0, 1.0);
+    CooMatrix coo;
+    coo.rows = coo.cols = n;
+    for (size_t i = 0; i < n; ++i) {
+        size_t first = i > half_width ? i - half_width : 0;
+        size_t last = std::min(n - 1, i + half_width);
+        for (size_t j = first; j <= last; ++j)
+            coo.add(static_cast<index_t>(i), static_cast<index_t>(j), dist(rng));
+    }
+    return coo;
+}
+
+// Longitudes de fila con ley de potencia (Pareto de exponente alpha) y media
+// aproximada avg_nnz; columnas uniformes. Imita grafos con nodos "hub".
+inline CooMatrix generate_power_law(size_t n, double avg_nnz, double alpha, std::mt19937_64& rng) {
+    std::uniform_real_distribution<real> dist(-1.0, 1.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<index_t> column(0, static_cast<index_t>(n - 1));
+
+    // Pareto con mínimo x_m tiene media x_m * alpha / (alpha - 1)
+    const double x_min = avg_nnz * (alpha - 1.0) / alpha;
+
+    CooMatrix coo;
+    coo.rows = coo.cols = n;
+    for (size_t i = 0; i < n; ++i) {
+        double len = x_min / std::pow(1.0 - unit(rng), 1.0 / alpha);
+        size_t nnz = std::clamp<size_t>(static_cast<size_t>(len), 1, n);
+        for (size_t e = 0; e < nnz; ++e)
+            coo.add(static_cast<index_t>(i), column(rng), dist(rng));
+    }
+    return coo;
+}
+
+// ============================================
+// KERNELS
+// ============================================
+// Cada kernel se compila en las tres variantes ISA (cpu_dispatch.hpp). El
+// compilador no vectoriza x[col[i]] (no emite gathers) en CSR ni en ELL: ahí
+// la variante solo cambia mul + add por FMA. SELL sí tiene variantes con
+// gathers explícitos, que es para lo que existen los trozos de C filas.
+ISA_INLINE void spmv_csr_rows_body(const CsrMatrix& A, const real* x, real* y, size_t first, size_t last) {
+    for (size_t i = first; i < last; ++i) {
+        real sum = 0.0;
+        for (size_t e = A.row_ptr[i]; e < A.row_ptr[i + 1]; ++e)
+            sum += A.val[e] * x[A.col[e]];
+        y[i] = sum;
+    }
+}
+ISA_VARIANTS(spmv_csr_rows, (const CsrMatrix& A, const real* x, real* y, size_t first, size_t last),
+             (A, x, y, first, last))
+
+inline void spmv_csr(const CsrMatrix& A, const real* x, real* y) {
+    spmv_csr_rows(A, x, y, 0, A.rows);
+}
+
+// Recorre por "columnas" de ELL: acceso contiguo a col/val y a y
+ISA_INLINE void spmv_ell_body(const EllMatrix& A, const real* x, real* y) {
+    std::fill(y, y + A.rows, 0.0);
+    for (size_t k = 0; k < A.width; ++k) {
+        const index_t* col = &A.col[k * A.rows];
+        const real* val = &A.val[k * A.rows];
+        for (size_t i = 0; i < A.rows; ++i)
+            y[i] += val[i] * x[col[i]];
+    }
+}
+ISA_VARIANTS(spmv_ell, (const EllMatrix& A, const real* x, real* y), (A, x, y))
+
+// Cada trozo de C filas se procesa como un ELL pequeño (C carriles SIMD)
+ISA_INLINE void spmv_sell_body(const SellMatrix& A, const real* x, real* y) {
+    const size_t C = A.chunk;
+    std::vector<real> acc(C);
+    for (size_t c = 0; c < A.chunk_width.size(); ++c) {
+        std::fill(acc.begin(), acc.end(), 0.0);
+        const index_t* col = &A.col[A.chunk_ptr[c]];
+        const real* val = &A.val[A.chunk_ptr[c]];
+        for (size_t k = 0; k < A.chunk_width[c]; ++k)
+            for (size_t r = 0; r < C; ++r)
+                acc[r] += val[k * C + r] * x[col[k * C + r]];
+        for (size_t r = 0; r < C && c * C + r < A.rows; ++r)
+            y[A.perm[c * C + r]] = acc[r];
+    }
+}
+
+inline void spmv_sell_sse2(const SellMatrix& A, const real* x, real* y) {
+    spmv_sell_body(A, x, y);
+}
+
+#if defined(ISA_X86)
+// Con C múltiplo del ancho SIMD cada franja de filas del trozo acumula en un
+// registro; x[col] se trae con un gather por columna del trozo (la forma con
+// máscara y origen en cero: la otra parte de un registro sin inicializar)
+ISA_TARGET_AVX2
+inline void spmv_sell_avx2(const SellMatrix& A, const real* x, real* y) {
+    const size_t C = A.chunk;
+    if (C % 4 != 0) {
+        spmv_sell_body(A, x, y);
+        return;
+    }
+    std::vector<real> acc(C);
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    for (size_t c = 0; c < A.chunk_width.size(); ++c) {
+        const index_t* col = &A.col[A.chunk_ptr[c]];
+        const real* val = &A.val[A.chunk_ptr[c]];
+        for (size_t r0 = 0; r0 < C; r0 += 4) {
+            __m256d sum = _mm256_setzero_pd();
+            for (size_t k = 0; k < A.chunk_width[c]; ++k) {
+                __m128i idx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(col + k * C + r0));
+                __m256d xs = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), x, idx, all, 8);
+                sum = _mm256_fmadd_pd(_mm256_loadu_pd(val + k * C + r0), xs, sum);
+            }
+            _mm256_storeu_pd(&acc[r0], sum);
+        }
+        for (size_t r = 0; r < C && c * C + r < A.rows; ++r)
+            y[A.perm[c * C + r]] = acc[r];
+    }
+}
+
+ISA_TARGET_AVX512
+inline void spmv_sell_avx512(const SellMatrix& A, const real* x, real* y) {
+    const size_t C = A.chunk;
+    if (C % 8 != 0) {
+        spmv_sell_body(A, x, y);
+        return;
+    }
+    std::vector<real> acc(C);
+    for (size_t c = 0; c < A.chunk_width.size(); ++c) {
+        const index_t* col = &A.col[A.chunk_ptr[c]];
+        const real* val = &A.val[A.chunk_ptr[c]];
+        for (size_t r0 = 0; r0 < C; r0 += 8) {
+            __m512d sum = _mm512_setzero_pd();
+            for (size_t k = 0; k < A.chunk_width[c]; ++k) {
+                __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(col + k * C + r0));
+                __m512d xs = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, idx, x, 8);
+                sum = _mm512_fmadd_pd(_mm512_loadu_pd(val + k * C + r0), xs, sum);
+            }
+            _mm512_storeu_pd(&acc[r0], sum);
+        }
+        for (size_t r = 0; r < C && c * C + r < A.rows; ++r)
+            y[A.perm[c * C + r]] = acc[r];
+    }
+}
+#endif
+
+inline void spmv_sell(const SellMatrix& A, const real* x, real* y) {
+#if defined(ISA_X86)
+    static void (*const variant)(const SellMatrix&, const real*, real*) =
+        isa_select(spmv_sell_sse2, spmv_sell_avx2, spmv_sell_avx512);
+    variant(A, x, y);
+#else
+    spmv_sell_sse2(A, x, y);
+#endif
+}
+
+// Fronteras de filas que reparten los no-ceros en `parts` partes iguales
+// (la fila completa va a una sola parte)
+inline std::vector<size_t> partition_rows_by_nnz(const CsrMatrix& A, size_t parts) {
+    std::vector<size_t> bounds(parts + 1, A.rows);
+    bounds[0] = 0;
+    for (size_t p = 1; p < parts; ++p) {
+        size_t target = A.nnz() * p / parts;
+        bounds[p] = std::lower_bound(A.row_ptr.begin(), A.row_ptr.end(), target) - A.row_ptr.begin();
+        bounds[p] = std::clamp(bounds[p], bounds[p - 1], A.rows);
+    }
+    return bounds;
+}
+
+struct SpmvThreadArgs {
+    const CsrMatrix* A;
+    const real* x;
+    real* y;
+    size_t first, last;
+};
+
+inline void* spmv_thread(void* arg) {
+    SpmvThreadArgs* args = static_cast<SpmvThreadArgs*>(arg);
+    spmv_csr_rows(*args->A, args->x, args->y, args->first, args->last);
+    return nullptr;
+}
+
+// SpMV CSR multihilo; bounds viene de partition_rows_by_nnz
+inline void spmv_csr_parallel(const CsrMatrix& A, const real* x, real* y,
+                              const std::vector<size_t>& bounds) {
+    size_t num_threads = bounds.size() - 1;
+    std::vector<pthread_t> hilos(num_threads);
+    std::vector<SpmvThreadArgs> args(num_threads);
+
+    for (size_t t = 0; t < num_threads; ++t) {
+        args[t] = {&A, x, y, bounds[t], bounds[t + 1]};
+        pthread_create(&hilos[t], nullptr, spmv_thread, &args[t]);
+    }
+    for (size_t t = 0; t < num_threads; ++t) {
+        pthread_join(hilos[t], nullptr);
+    }
+}
+
+// ============================================
+// BYTES MOVIDOS (para GB/s efectivos)
+// ============================================
+// Se cuenta cada estructura una vez: valores, índices, x leído e y escrito
+inline double spmv_bytes(const CsrMatrix& A) {
+    return A.nnz() * (sizeof(real) + sizeof(index_t)) + (A.rows + 1) * sizeof(size_t)
+         + A.cols * sizeof(real) + A.rows * sizeof(real);
+}
+
+inline double spmv_bytes(const EllMatrix& A) {
+    return A.val.size() * (sizeof(real) + sizeof(index_t))
+         + A.cols * sizeof(real) + A.rows * sizeof(real);
+}
+
+inline double spmv_bytes(const SellMatrix& A) {
+    return A.val.size() * (sizeof(real) + sizeof(index_t)) + A.perm.size() * sizeof(index_t)
+         + A.cols * sizeof(real) + A.rows * sizeof(real);
+}
@@ -0,0 +1,140 @@
+// Multiplicación Strassen-Winograd: 7 productos y 15 sumas por nivel en
+// lugar de 8 productos. Se recursa hasta que alguna dimensión es <= cutoff
+// y ahí se llama al motor empaquetado (blocking estilo GotoBLAS).
+//
+// Dimensiones impares: se aplica Strassen sobre la parte par (2m x 2k) * (2k x 2n)
+// y la fila/columna sobrante se corrige después con productos directos
+// (peeling dinámico), sin rellenar con ceros.
+//
+// Los temporales X e Y de cada nivel salen de un workspace reservado una sola
+// vez (StrassenWorkspace); la recursión no reserva memoria.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include "gemm_empaquetado.hpp"
+
+// Redondea a múltiplos de 8 reales para que cada temporal empiece en una
+// línea de caché
+inline size_t round_to_line(size_t n) { return (n + 7) / 8 * 8; }
+
+// Reales de workspace que necesita la recursión para (M x K) * (K x N)
+inline size_t strassen_workspace_size(size_t M, size_t K, size_t N, size_t cutoff) {
+    if (std::min({M, K, N}) <= cutoff) return 0;
+    size_t m2 = M / 2, k2 = K / 2, n2 = N / 2;
+    size_t x = round_to_line(std::max(m2 * k2, m2 * n2));
+    size_t y = round_to_line(k2 * n2);
+    return x + y + strassen_workspace_size(m2, k2, n2, cutoff);
+}
+
+struct StrassenWorkspace {
+    size_t cutoff;
+    aligned_array<real> data;
+    PackBuffers pack;  // paneles del caso base, compartidos por todas las hojas
+};
+
+inline StrassenWorkspace make_strassen_workspace(size_t M, size_t K, size_t N, size_t cutoff) {
+    return {cutoff, make_aligned_array<real>(strassen_workspace_size(M, K, N, cutoff)), PackBuffers{}};
+}
+
+// Z = X + Y y Z = X - Y elemento a elemento (Z puede coincidir con X o Y)
+inline void mat_add(ConstRealView X, ConstRealView Y, RealView Z) {
+    for (size_t i = 0; i < Z.rows(); ++i)
+        for (size_t j = 0; j < Z.cols(); ++j)
+            Z(i,j) = X(i,j) + Y(i,j);
+}
+
+inline void mat_sub(ConstRealView X, ConstRealView Y, RealView Z) {
+    for (size_t i = 0; i < Z.rows(); ++i)
+        for (size_t j = 0; j < Z.cols(); ++j)
+            Z(i,j) = X(i,j) - Y(i,j);
+}
+
+// Corrige la fila/columna que el peeling dejó fuera de la parte par
+inline void strassen_peel_fixup(ConstRealView A, ConstRealView B, RealView C,
+                                size_t M2, size_t K2, size_t N2) {
+    const size_t M = A.rows(), K = A.cols(), N = B.cols();
+
+    // K impar: C[0:M2, 0:N2] += A[0:M2, K-1] * B[K-1, 0:N2]
+    if (K2 < K) {
+        for (size_t i = 0; i < M2; ++i) {
+            real a = A(i, K - 1);
+            for (size_t j = 0; j < N2; ++j) C(i,j) += a * B(K - 1, j);
+        }
+    }
+    // N impar: última columna completa para las filas de la parte par
+    if (N2 < N) {
+        for (size_t i = 0; i < M2; ++i) {
+            real sum = 0.0;
+            for (size_t k = 0; k < K; ++k) sum += A(i,k) * B(k, N - 1);
+            C(i, N - 1) = sum;
+        }
+    }
+    // M impar: última fila completa
+    if (M2 < M) {
+        for (size_t j = 0; j < N; ++j) C(M - 1, j) = 0.0;
+        for (size_t k = 0; k < K; ++k) {
+            real a = A(M - 1, k);
+            for (size_t j = 0; j < N; ++j) C(M - 1, j) += a * B(k, j);
+        }
+    }
+}
+
+// C = A * B. `ws` apunta a la parte libre del workspace de este nivel.
+inline void strassen_rec(ConstRealView A, ConstRealView B, RealView C,
+                         StrassenWorkspace& w, real* ws) {
+    const size_t M = A.rows(), K = A.cols(), N = B.cols();
+
+    if (std::min({M, K, N}) <= w.cutoff) {
+        C.fill(0.0);
+        matmul_packed_tile(A, B, C, 0, M, 0, N, w.pack);
+        return;
+    }
+
+    const size_t m = M / 2, k = K / 2, n = N / 2;
+
+    ConstRealView A11 = A.block(0, 0, m, k), A12 = A.block(0, k, m, k);
+    ConstRealView A21 = A.block(m, 0, m, k), A22 = A.block(m, k, m, k);
+    ConstRealView B11 = B.block(0, 0, k, n), B12 = B.block(0, n, k, n);
+    ConstRealView B21 = B.block(k, 0, k, n), B22 = B.block(k, n, k, n);
+    RealView C11 = C.block(0, 0, m, n), C12 = C.block(0, n, m, n);
+    RealView C21 = C.block(m, 0, m, n), C22 = C.block(m, n, m, n);
+
+    // Temporales: X guarda las S (m x k) y P1 (m x n), Y guarda las T (k x n)
+    real* x_mem = ws;
+    real* y_mem = x_mem + round_to_line(std::max(m * k, m * n));
+    real* next = y_mem + round_to_line(k * n);
+    RealView XS(x_mem, m, k), XP(x_mem, m, n), Y(y_mem, k, n);
+
+    // Orden de Boyer, Dumas, Pernet y Zhou (2009): dos temporales en total
+    mat_sub(A11, A21, XS);                 // S3
+    mat_sub(B22, B12, Y);                  // T3
+    strassen_rec(XS, Y, C21, w, next);     // P7 -> C21
+    mat_add(A21, A22, XS);                 // S1
+    mat_sub(B12, B11, Y);                  // T1
+    strassen_rec(XS, Y, C22, w, next);     // P5 -> C22
+    mat_sub(XS, A11, XS);                  // S2 = S1 - A11
+    mat_sub(B22, Y, Y);                    // T2 = B22 - T1
+    strassen_rec(XS, Y, C12, w, next);     // P6 -> C12
+    mat_sub(A12, XS, XS);                  // S4 = A12 - S2
+    strassen_rec(XS, B22, C11, w, next);   // P3 -> C11
+    strassen_rec(A11, B11, XP, w, next);   // P1 -> X
+    mat_add(XP, C12, C12);                 // U2 = P1 + P6
+    mat_add(C12, C21, C21);                // U3 = U2 + P7
+    mat_add(C12, C22, C12);                // U4 = U2 + P5
+    mat_add(C21, C22, C22);                // U7 = U3 + P5  (C22 final)
+    mat_add(C12, C11, C12);                // U5 = U4 + P3  (C12 final)
+    mat_sub(Y, B21, Y);                    // T4 = T2 - B21
+    strassen_rec(A22, Y, C11, w, next);    // P4 -> C11
+    mat_sub(C21, C11, C21);                // U6 = U3 - P4  (C21 final)
+    strassen_rec(A12, B21, C11, w, next);  // P2 -> C11
+    mat_add(XP, C11, C11);                 // U1 = P1 + P2  (C11 final)
+
+    strassen_peel_fixup(A, B, C, 2 * m, 2 * k, 2 * n);
+}
+
+// C = A * B con Strassen-Winograd usando un workspace ya reservado para
+// estas dimensiones y este cutoff
+inline void matmul_strassen(ConstRealView A, ConstRealView B, RealView C, StrassenWorkspace& ws) {
+    strassen_rec(A, B, C, ws, ws.data.get());
+}
@@ -5,6 +5,8 @@
 #include <iomanip>
 #include <vector>
 
+#include "../comun/benchmark.hpp"
+
 // Configuración para prueba específica
 constexpr long long NUM_TERMINOS = 10000LL;  // Solo 10,000 para prueba
 constexpr int NUM_HILOS = 4;
@@ -24,20 +26,6 @@ struct BusyWaitData {
     double suma_global;
 };
 
-// ============================================
-// CLASE PARA TIMING
-// ============================================
-class Timer {
-    std::chrono::high_resolution_clock::time_point start_;
-public:
-    Timer() : start_(std::chrono::high_resolution_clock::now()) {}
-
-    double elapsed() const {
-        auto end = std::chrono::high_resolution_clock::now();
-        return std::chrono::duration<double>(end - start_).count();
-    }
-};
-
 // ============================================
 // BUSY-WAITING DENTRO DEL BUCLE
 // ============================================
@@ -152,18 +140,21 @@ void analizar_busy_waiting_dentro() {
 
     // Calcular secuencial primero
     std::cout << "🔄 CALCULANDO VERSIÓN SECUENCIAL...\n";
-    Timer timer_sec;
-    double pi_secuencial = calcular_pi_secuencial(NUM_TERMINOS);
-    double tiempo_secuencial = timer_sec.elapsed();
+    double pi_secuencial = 0.0;
+    double tiempo_secuencial = run_benchmark("SECUENCIAL", [&]() {
+        pi_secuencial = calcular_pi_secuencial(NUM_TERMINOS);
+    }).median;
 
     std::cout << "   π secuencial: " << std::fixed << std::setprecision(10) << pi_secuencial << "\n";
     std::cout << "   Tiempo secuencial: " << std::setprecision(6) << tiempo_secuencial << "s\n\n";
 
     // Calcular busy-waiting dentro
     std::cout << "🔄 CALCULANDO BUSY-WAITING DENTRO...\n";
-    Timer timer_bw;
-    double pi_bw_dentro = calcular_pi_busy_waiting_dentro(NUM_TERMINOS);
-    double tiempo_bw_dentro = timer_bw.elapsed();
+    // Una sola corrida: cada ejecución imprime el progreso de los hilos
+    double pi_bw_dentro = 0.0;
+    double tiempo_bw_dentro = run_benchmark("BUSY-WAITING_DENTRO", [&]() {
+        pi_bw_dentro = calcular_pi_busy_waiting_dentro(NUM_TERMINOS);
+    }, single_run_config()).median;
 
     std::cout << "\n   π busy-waiting dentro: " << std::fixed << std::setprecision(10) << pi_bw_dentro << "\n";
     std::cout << "   Tiempo busy-waiting dentro: " << std::setprecision(6) << tiempo_bw_dentro << "s\n\n";
@@ -220,22 +211,20 @@ void prueba_diferentes_configuraciones() {
         shared_data.flag = 0;
         shared_data.suma_global = 0.0;
 
-        Timer timer;
-
-        // Crear hilos
-        for (int i = 0; i < hilos; i++) {
-            args_arr[i].thread_data.id = i;
-            args_arr[i].thread_data.n_terminos = NUM_TERMINOS;
-            args_arr[i].shared_data = &shared_data;
-            pthread_create(&hilos_arr[i], nullptr, thread_busy_waiting_dentro, &args_arr[i]);
-        }
-
-        // Esperar hilos
-        for (int i = 0; i < hilos; i++) {
-            pthread_join(hilos_arr[i], nullptr);
-        }
-
-        double tiempo = timer.elapsed();
+        double tiempo = run_benchmark("BUSY-WAITING_DENTRO/hilos=" + std::to_string(hilos), [&]() {
+            // Crear hilos
+            for (int i = 0; i < hilos; i++) {
+                args_arr[i].thread_data.id = i;
+                args_arr[i].thread_data.n_terminos = NUM_TERMINOS;
+                args_arr[i].shared_data = &shared_data;
+                pthread_create(&hilos_arr[i], nullptr, thread_busy_waiting_dentro, &args_arr[i]);
+            }
+
+            // Esperar hilos
+            for (int i = 0; i < hilos; i++) {
+                pthread_join(hilos_arr[i], nullptr);
+            }
+        }, single_run_config()).median;
         double pi = 4.0 * shared_data.suma_global;
 
         std::cout << "   Resultado: π ≈ " << std::fixed << std::setprecision(10) << pi << "\n";
@@ -272,5 +261,7 @@ int main() {
     std::cout << "   • Semáforos para control de acceso\n";
     std::cout << "   • Barreras para sincronización grupal\n";
 
+    save_bench_report("bussy_for_dentro");
+
     return 0;
 }
\ No newline at end of file
@@ -5,12 +5,27 @@
 #include <iomanip>
 #include <vector>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "../comun/benchmark.hpp"
+#include "../comun/roofline.hpp"
+#include "../comun/scaling.hpp"
+#include "../comun/thread_pool.hpp"
+#include "../comun/work_stealing.hpp"
+#include "../comun/locks.hpp"
+#include "../comun/parallel_reduce.hpp"
 
 // Configuración
 constexpr long long NUM_TERMINOS = 10000000LL;
-constexpr int NUM_HILOS = 4;
+// BUSY-WAITING DENTRO pasa el turno en cada término: con NUM_TERMINOS
+// tardaría minutos, así que se mide con menos
+constexpr long long TERMINOS_BW_DENTRO = 100000LL;
+constexpr int NUM_HILOS = 4;  // por defecto; --hilos N lo cambia
 constexpr double PI_REAL = 3.14159265358979323846;
 
 // ============================================
@@ -19,49 +34,301 @@ constexpr double PI_REAL = 3.14159265358979323846;
 
 struct ThreadData {
     int id;
+    int num_hilos;
     long long n_terminos;
     double suma_local;
 };
 
+// Turno compartido: suma_global solo la toca el hilo que tiene el turno; el
+// store release del turno siguiente publica su suma al acquire del próximo
 struct BusyWaitData {
-    volatile long flag;
+    std::atomic<long> flag;
     double suma_global;
 };
 
-struct MutexData {
-    pthread_mutex_t mutex;
-    double suma_global;
+// ============================================
+// LANZAMIENTO DE LOS HILOS
+// ============================================
+// Todas las estrategias corren sus hilos con lanzar_hilos: por defecto en el
+// pool persistente (comun/thread_pool.hpp), o creando y juntando un pthread
+// por hilo en cada llamada, como antes (--pool compara las dos).
+enum class Lanzamiento { Pool, PorLlamada };
+Lanzamiento lanzamiento = Lanzamiento::Pool;
+
+const char* nombre_lanzamiento(Lanzamiento l) {
+    return l == Lanzamiento::Pool ? "pool" : "pthread_create";
+}
+
+// run(tareas, f) con la interfaz de ThreadPool::run: f(id) en un hilo por
+// tarea, todas a la vez, según `lanzamiento`. Es el runner que reciben las
+// estrategias escritas sobre parallel_reduce (comun/parallel_reduce.hpp)
+struct LanzadorHilos {
+    template <typename F>
+    void run(int tareas, const F& f) {
+        if (lanzamiento == Lanzamiento::Pool) {
+            default_pool().run(tareas, f);
+            return;
+        }
+
+        struct Tarea {
+            const F* f;
+            int id;
+        };
+        std::vector<Tarea> tareas_hilo(tareas);
+        std::vector<pthread_t> hilos(tareas);
+        for (int i = 0; i < tareas; i++) {
+            tareas_hilo[i] = {&f, i};
+            pthread_create(&hilos[i], nullptr, [](void* arg) -> void* {
+                Tarea* t = static_cast<Tarea*>(arg);
+                (*t->f)(t->id);
+                return nullptr;
+            }, &tareas_hilo[i]);
+        }
+
+        for (int i = 0; i < tareas; i++) {
+            pthread_join(hilos[i], nullptr);
+        }
+    }
 };
+LanzadorHilos lanzador;
+
+// Completa thread_data de cada args[i] y corre rutina(&args[i]) en un hilo
+// por elemento, todos a la vez; vuelve cuando terminan
+template <typename Args>
+void lanzar_hilos(std::vector<Args>& args, long long n, void* (*rutina)(void*)) {
+    for (size_t i = 0; i < args.size(); i++) {
+        args[i].thread_data.id = static_cast<int>(i);
+        args[i].thread_data.num_hilos = static_cast<int>(args.size());
+        args[i].thread_data.n_terminos = n;
+        args[i].thread_data.suma_local = 0.0;
+    }
+
+    lanzador.run(static_cast<int>(args.size()), [&](int id) { rutina(&args[id]); });
+}
 
 // ============================================
-// CLASE PARA TIMING
+// KERNEL DE LA SERIE
 // ============================================
-class Timer {
-    std::chrono::high_resolution_clock::time_point start_;
-public:
-    Timer() : start_(std::chrono::high_resolution_clock::now()) {}
+// Suma de (-1)^i / (2i + 1) para i en [first, last).
+//
+// El bucle original lleva factor = -factor de una iteración a la siguiente
+// y un solo acumulador: cada suma espera a la anterior y, sin -ffast-math,
+// el compilador no puede reordenarlas para vectorizar. El kernel toma los
+// términos de a pares desde un i par,
+//   1/(2i+1) - 1/(2i+3) = 2 / ((2i+1)(2i+3)),
+// así ningún término depende del signo del anterior, y reparte los pares en
+// SERIE_ACUM acumuladores independientes que el compilador lleva a carriles
+// SIMD (2 vectores AVX-512, 4 AVX2 u 8 SSE2, según la variante ISA).
+//
+// La suma compensada (Neumaier) guarda en cada acumulador el error de
+// redondeo de cada suma y lo devuelve al total al final.
+//
+// BUSY-WAITING DENTRO y RANURAS siguen sumando término a término: lo que
+// miden es el costo de tocar memoria compartida en cada término.
+enum class ModoSuma { Escalar, Vectorizada, Compensada };
+ModoSuma modo_suma = ModoSuma::Vectorizada;  // --suma lo cambia
+
+const char* nombre_modo_suma(ModoSuma m) {
+    switch (m) {
+        case ModoSuma::Escalar: return "escalar";
+        case ModoSuma::Compensada: return "compensada";
+        default: return "vectorizada";
+    }
+}
 
-    double elapsed() const {
-        auto end = std::chrono::high_resolution_clock::now();
-        return std::chrono::duration<double>(end - start_).count();
+// Modo por nombre; false (y modo sin tocar) si no es ninguno de los tres
+bool leer_modo_suma(const std::string& nombre, ModoSuma& modo) {
+    for (ModoSuma m : {ModoSuma::Escalar, ModoSuma::Vectorizada, ModoSuma::Compensada}) {
+        if (nombre == nombre_modo_suma(m)) {
+            modo = m;
+            return true;
+        }
+    }
+    return false;
+}
+
+constexpr int SERIE_ACUM = 16;
+
+// s += x guardando en c lo que se perdió al redondear
+inline void sumar_neumaier(double& s, double& c, double x) {
+    double t = s + x;
+    c += std::abs(s) >= std::abs(x) ? (s - t) + x : (x - t) + s;
+    s = t;
+}
+
+// `pares` pares de términos, el primero con denominador d0 = 2i + 1 (i par).
+// Deja en out[0] la suma y en out[1] la compensación (0 sin compensar).
+ISA_INLINE void sumar_pares_body(double d0, long long pares, bool compensada, double* out) {
+    double s[SERIE_ACUM] = {}, c[SERIE_ACUM] = {}, d[SERIE_ACUM];
+    for (int l = 0; l < SERIE_ACUM; l++) d[l] = d0 + 4.0 * l;
+
+    long long p = 0;
+    if (compensada) {
+        for (; p + SERIE_ACUM <= pares; p += SERIE_ACUM) {
+            for (int l = 0; l < SERIE_ACUM; l++) {
+                double x = 2.0 / (d[l] * (d[l] + 2.0));
+                double t = s[l] + x;
+                c[l] += std::abs(s[l]) >= std::abs(x) ? (s[l] - t) + x : (x - t) + s[l];
+                s[l] = t;
+                d[l] += 4.0 * SERIE_ACUM;
+            }
+        }
+    } else {
+        for (; p + SERIE_ACUM <= pares; p += SERIE_ACUM) {
+            for (int l = 0; l < SERIE_ACUM; l++) {
+                s[l] += 2.0 / (d[l] * (d[l] + 2.0));
+                d[l] += 4.0 * SERIE_ACUM;
+            }
+        }
+    }
+    // Pares que no completan una vuelta
+    for (int l = 0; p < pares; p++, l++) {
+        double x = 2.0 / (d[l] * (d[l] + 2.0));
+        if (compensada) sumar_neumaier(s[l], c[l], x);
+        else s[l] += x;
+    }
+
+    double total = 0.0, comp = 0.0;
+    for (int l = 0; l < SERIE_ACUM; l++) {
+        if (compensada) {
+            sumar_neumaier(total, comp, s[l]);
+            comp += c[l];
+        } else {
+            total += s[l];
+        }
+    }
+    out[0] = total;
+    out[1] = comp;
+}
+
+ISA_VARIANTS(sumar_pares, (double d0, long long pares, bool compensada, double* out),
+             (d0, pares, compensada, out))
+
+double sumar_serie(long long first, long long last) {
+    if (modo_suma == ModoSuma::Escalar) {
+        double factor = (first % 2 == 0) ? 1.0 : -1.0;
+        double suma = 0.0;
+
+        for (long long i = first; i < last; i++) {
+            suma += factor / (2 * i + 1);
+            factor = -factor;
+        }
+        return suma;
     }
-};
+
+    // Los pares empiezan en un i par y terminan completos: el término
+    // impar del principio y el par del final van aparte
+    double cabeza = 0.0, cola = 0.0;
+    if (first % 2 != 0 && first < last) {
+        cabeza = -1.0 / (2 * first + 1);
+        first++;
+    }
+    if (first < last && (last - first) % 2 != 0) {
+        last--;
+        cola = 1.0 / (2 * last + 1);
+    }
+
+    double r[2] = {0.0, 0.0};
+    if (first < last) sumar_pares(2.0 * first + 1.0, (last - first) / 2, modo_suma == ModoSuma::Compensada, r);
+    sumar_neumaier(r[0], r[1], cabeza);
+    sumar_neumaier(r[0], r[1], cola);
+    return r[0] + r[1];
+}
 
 // ============================================
 // 1. SECUENCIAL (sin threads)
 // ============================================
 double calcular_pi_secuencial(long long n) {
-    double suma = 0.0;
-    double factor = 1.0;
+    return 4.0 * sumar_serie(0, n);
+}
 
-    for (long long i = 0; i < n; i++) {
-        suma += factor / (2 * i + 1);
-        factor = -factor;
+// ============================================
+// ESPERA DEL TURNO
+// ============================================
+// Cómo espera un hilo a que flag valga su turno; notify avisa después de
+// pasar el turno. Las BUSY-WAITING son plantillas sobre la política:
+//   EsperaSpin:    gira releyendo flag (el bucle original, ya con atomic)
+//   EsperaPausa:   gira con pause: menos consumo y no inunda el pipeline de
+//                  lecturas especulativas al salir
+//   EsperaYield:   gira un rato y después cede la CPU con sched_yield
+//   EsperaAtomica: atomic::wait de C++20, que duerme en un futex hasta el
+//                  notify. Todos esperan sobre el mismo flag con distinto
+//                  turno, así que hay que despertar a todos (notify_all): con
+//                  notify_one el despertado puede no ser el del turno y el
+//                  que sí es quedaría dormido
+struct EsperaSpin {
+    static constexpr const char* nombre = "spin";
+    static void esperar(const std::atomic<long>& flag, long turno) {
+        while (flag.load(std::memory_order_acquire) != turno) {
+        }
     }
+    static void notificar(std::atomic<long>&) {}
+};
 
-    return 4.0 * suma;
+struct EsperaPausa {
+    static constexpr const char* nombre = "pausa";
+    static void esperar(const std::atomic<long>& flag, long turno) {
+        while (flag.load(std::memory_order_acquire) != turno) cpu_relax();
+    }
+    static void notificar(std::atomic<long>&) {}
+};
+
+struct EsperaYield {
+    static constexpr const char* nombre = "yield";
+    static void esperar(const std::atomic<long>& flag, long turno) {
+        SpinWait spin;
+        while (flag.load(std::memory_order_acquire) != turno) spin.wait();
+    }
+    static void notificar(std::atomic<long>&) {}
+};
+
+struct EsperaAtomica {
+    static constexpr const char* nombre = "wait";
+    static void esperar(const std::atomic<long>& flag, long turno) {
+        long actual;
+        while ((actual = flag.load(std::memory_order_acquire)) != turno) flag.wait(actual, std::memory_order_acquire);
+    }
+    static void notificar(std::atomic<long>& flag) { flag.notify_all(); }
+};
+
+// Espera el turno de my_rank, corre accion() y pasa el turno al siguiente
+template <typename Espera, typename Accion>
+void en_turno(std::atomic<long>& flag, int my_rank, int num_hilos, const Accion& accion) {
+    Espera::esperar(flag, my_rank);
+    accion();
+    flag.store((my_rank + 1) % num_hilos, std::memory_order_release);
+    Espera::notificar(flag);
 }
 
+template <typename Espera>
+void sumar_en_turno(BusyWaitData* shared, int my_rank, int num_hilos, double valor) {
+    en_turno<Espera>(shared->flag, my_rank, num_hilos, [&]() { shared->suma_global += valor; });
+}
+
+// El turno como combinador de parallel_reduce: los parciales se combinan en
+// orden de tarea, cada uno cuando le llega el turno
+template <typename Espera>
+struct CombinarEnTurno {
+    static constexpr const char* name = Espera::nombre;
+
+    template <typename T, typename Op>
+    class State {
+        std::atomic<long> flag_{0};
+        int tareas_;
+        T total_;
+        const Op& op_;
+
+    public:
+        State(int tareas, const T& identidad, const Op& op) : tareas_(tareas), total_(identidad), op_(op) {}
+
+        void combine(int id, const T& parcial) {
+            en_turno<Espera>(flag_, id, tareas_, [&]() { total_ = op_(total_, parcial); });
+        }
+
+        T result() const { return total_; }
+    };
+};
+
 // ============================================
 // 2. BUSY-WAITING DENTRO DEL BUCLE
 // ============================================
@@ -70,46 +337,41 @@ struct BusyWaitDentroArgs {
     BusyWaitData* shared_data;
 };
 
+template <typename Espera>
 void* thread_busy_waiting_dentro(void* arg) {
     BusyWaitDentroArgs* args = static_cast<BusyWaitDentroArgs*>(arg);
     int my_rank = args->thread_data.id;
+    int num_hilos = args->thread_data.num_hilos;
     long long n = args->thread_data.n_terminos;
     BusyWaitData* shared = args->shared_data;
 
-    long long my_n = n / NUM_HILOS;
-    long long my_first_i = my_n * my_rank;
-    long long my_last_i = my_first_i + my_n;
+    // Los primeros n % num_hilos hilos llevan un término más
+    long long my_first_i, my_last_i;
+    pool_chunk(0, n, num_hilos, my_rank, my_first_i, my_last_i);
 
     double factor = (my_first_i % 2 == 0) ? 1.0 : -1.0;
 
     for (long long i = my_first_i; i < my_last_i; i++) {
-        while (shared->flag != my_rank);
-        shared->suma_global += factor / (2 * i + 1);
+        sumar_en_turno<Espera>(shared, my_rank, num_hilos, factor / (2 * i + 1));
         factor = -factor;
-        shared->flag = (my_rank + 1) % NUM_HILOS;
     }
 
     return nullptr;
 }
 
-double calcular_pi_busy_waiting_dentro(long long n) {
-    pthread_t hilos[NUM_HILOS];
-    BusyWaitDentroArgs args[NUM_HILOS];
+template <typename Espera>
+double calcular_pi_busy_waiting_dentro(long long n, int num_hilos) {
+    std::vector<BusyWaitDentroArgs> args(num_hilos);
     BusyWaitData shared_data;
 
     shared_data.flag = 0;
     shared_data.suma_global = 0.0;
 
-    for (int i = 0; i < NUM_HILOS; i++) {
-        args[i].thread_data.id = i;
-        args[i].thread_data.n_terminos = n;
+    for (int i = 0; i < num_hilos; i++) {
         args[i].shared_data = &shared_data;
-        pthread_create(&hilos[i], nullptr, thread_busy_waiting_dentro, &args[i]);
     }
 
-    for (int i = 0; i < NUM_HILOS; i++) {
-        pthread_join(hilos[i], nullptr);
-    }
+    lanzar_hilos(args, n, thread_busy_waiting_dentro<Espera>);
 
     return 4.0 * shared_data.suma_global;
 }
@@ -117,125 +379,188 @@ double calcular_pi_busy_waiting_dentro(long long n) {
 // ============================================
 // 3. BUSY-WAITING FUERA DEL BUCLE
 // ============================================
-struct BusyWaitFueraArgs {
+// Desde aquí las estrategias que suman un bloque por hilo y solo difieren
+// en cómo juntan las sumas son parallel_reduce con reparto en bloques y el
+// combinador de cada una; corren en lanzador, así que --sin-pool también
+// las afecta.
+template <typename Combinador>
+double calcular_pi_reduccion(long long n, int num_hilos) {
+    return 4.0 * parallel_reduce<Combinador>(0LL, n, num_hilos, 0.0, sumar_serie, std::plus<double>(),
+                                             Partitioning{}, lanzador);
+}
+
+template <typename Espera>
+double calcular_pi_busy_waiting_fuera(long long n, int num_hilos) {
+    return calcular_pi_reduccion<CombinarEnTurno<Espera>>(n, num_hilos);
+}
+
+// ============================================
+// 4. MUTEX
+// ============================================
+// Con cualquier política de lock: MUTEX es pthread_mutex_t y MUTEX_TTAS,
+// MUTEX_TICKET, MUTEX_MCS y MUTEX_FUTEX las de comun/locks.hpp
+template <typename Lock>
+double calcular_pi_mutex(long long n, int num_hilos) {
+    return calcular_pi_reduccion<LockCombine<Lock>>(n, num_hilos);
+}
+
+// ============================================
+// COMBINACIONES SIN LOCK
+// ============================================
+// ATOMIC_CAS y ARBOL son combinadores de parallel_reduce. RANURAS acumulan
+// en memoria para mostrar el false sharing y ATOMIC_REF usa fetch_add, así
+// que siguen con sus propios hilos.
+
+// Suma de los términos del hilo en un registro; queda en d.suma_local
+void sumar_local(ThreadData& d) {
+    long long my_first_i, my_last_i;
+    pool_chunk(0, d.n_terminos, d.num_hilos, d.id, my_first_i, my_last_i);
+
+    d.suma_local = sumar_serie(my_first_i, my_last_i);
+}
+
+// ============================================
+// 5. ATOMIC<DOUBLE> CON CAS
+// ============================================
+// Sin fetch_add: AtomicCombine lee el total, calcula el nuevo y
+// compare_exchange lo escribe solo si nadie lo cambió en el medio; si no,
+// reintenta. Con p hilos hay a lo sumo p - 1 reintentos por hilo.
+double calcular_pi_atomic_cas(long long n, int num_hilos) {
+    return calcular_pi_reduccion<AtomicCombine>(n, num_hilos);
+}
+
+// ============================================
+// 6-7. RANURA POR HILO (CON Y SIN RELLENO)
+// ============================================
+// Cada hilo acumula término a término en su propia ranura (volatile: una
+// escritura a memoria por término) y el hilo principal suma las ranuras al
+// final. Sin relleno, 8 ranuras comparten una línea de 64 bytes y cada
+// escritura invalida la línea en los demás núcleos (false sharing) aunque
+// ningún hilo lea la ranura de otro; con relleno cada ranura tiene su línea.
+struct alignas(64) RanuraConRelleno {
+    double valor;
+};
+
+struct RanuraArgs {
     ThreadData thread_data;
-    BusyWaitData* shared_data;
+    volatile double* ranura;
 };
 
-void* thread_busy_waiting_fuera(void* arg) {
-    BusyWaitFueraArgs* args = static_cast<BusyWaitFueraArgs*>(arg);
-    int my_rank = args->thread_data.id;
-    long long n = args->thread_data.n_terminos;
-    BusyWaitData* shared = args->shared_data;
+void* thread_ranura(void* arg) {
+    RanuraArgs* args = static_cast<RanuraArgs*>(arg);
+    const ThreadData& d = args->thread_data;
 
-    long long my_n = n / NUM_HILOS;
-    long long my_first_i = my_n * my_rank;
-    long long my_last_i = my_first_i + my_n;
+    long long my_first_i, my_last_i;
+    pool_chunk(0, d.n_terminos, d.num_hilos, d.id, my_first_i, my_last_i);
 
     double factor = (my_first_i % 2 == 0) ? 1.0 : -1.0;
-    double my_sum = 0.0;
+    volatile double* ranura = args->ranura;
 
     for (long long i = my_first_i; i < my_last_i; i++) {
-        my_sum += factor / (2 * i + 1);
+        *ranura = *ranura + factor / (2 * i + 1);
         factor = -factor;
     }
 
-    while (shared->flag != my_rank);
-    shared->suma_global += my_sum;
-    shared->flag = (my_rank + 1) % NUM_HILOS;
-
     return nullptr;
 }
 
-double calcular_pi_busy_waiting_fuera(long long n) {
-    pthread_t hilos[NUM_HILOS];
-    BusyWaitFueraArgs args[NUM_HILOS];
-    BusyWaitData shared_data;
+double calcular_pi_ranuras(long long n, int num_hilos, bool relleno) {
+    std::vector<double> juntas(num_hilos, 0.0);
+    std::vector<RanuraConRelleno> separadas(num_hilos, RanuraConRelleno{0.0});
+    std::vector<RanuraArgs> args(num_hilos);
+    for (int i = 0; i < num_hilos; i++)
+        args[i].ranura = relleno ? &separadas[i].valor : &juntas[i];
 
-    shared_data.flag = 0;
-    shared_data.suma_global = 0.0;
+    lanzar_hilos(args, n, thread_ranura);
 
-    for (int i = 0; i < NUM_HILOS; i++) {
-        args[i].thread_data.id = i;
-        args[i].thread_data.n_terminos = n;
-        args[i].shared_data = &shared_data;
-        pthread_create(&hilos[i], nullptr, thread_busy_waiting_fuera, &args[i]);
-    }
+    double suma = 0.0;
+    for (int i = 0; i < num_hilos; i++) suma += relleno ? separadas[i].valor : juntas[i];
+    return 4.0 * suma;
+}
 
-    for (int i = 0; i < NUM_HILOS; i++) {
-        pthread_join(hilos[i], nullptr);
-    }
+double calcular_pi_ranuras_sin_relleno(long long n, int num_hilos) {
+    return calcular_pi_ranuras(n, num_hilos, false);
+}
 
-    return 4.0 * shared_data.suma_global;
+double calcular_pi_ranuras_con_relleno(long long n, int num_hilos) {
+    return calcular_pi_ranuras(n, num_hilos, true);
 }
 
 // ============================================
-// 4. MUTEX
+// 8. REDUCCIÓN EN ÁRBOL
 // ============================================
-struct MutexArgs {
+// ceil(log2 p) rondas: en la ronda s el hilo id (múltiplo de 2s) espera al
+// hilo id + s y suma su subárbol; el que no es múltiplo publica lo que lleva
+// y termina. El hilo 0 queda con el total. Ningún dato lo escriben dos hilos
+// y la cadena de sumas tiene profundidad log p en vez de p.
+double calcular_pi_arbol(long long n, int num_hilos) {
+    return calcular_pi_reduccion<TreeCombine>(n, num_hilos);
+}
+
+// ============================================
+// 9. ATOMIC_REF (C++20)
+// ============================================
+// El total es un double común, como en MUTEX; atomic_ref vuelve atómica
+// solo la suma final de cada hilo (fetch_add sobre double, sin lock).
+struct AtomicRefArgs {
     ThreadData thread_data;
-    MutexData* shared_data;
+    double* suma_global;
 };
 
-void* thread_mutex(void* arg) {
-    MutexArgs* args = static_cast<MutexArgs*>(arg);
-    int my_rank = args->thread_data.id;
-    long long n = args->thread_data.n_terminos;
-    MutexData* shared = args->shared_data;
-
-    long long my_n = n / NUM_HILOS;
-    long long my_first_i = my_n * my_rank;
-    long long my_last_i = my_first_i + my_n;
-
-    double factor = (my_first_i % 2 == 0) ? 1.0 : -1.0;
-    double my_sum = 0.0;
+void* thread_atomic_ref(void* arg) {
+    AtomicRefArgs* args = static_cast<AtomicRefArgs*>(arg);
+    sumar_local(args->thread_data);
 
-    for (long long i = my_first_i; i < my_last_i; i++) {
-        my_sum += factor / (2 * i + 1);
-        factor = -factor;
-    }
-
-    pthread_mutex_lock(&shared->mutex);
-    shared->suma_global += my_sum;
-    pthread_mutex_unlock(&shared->mutex);
+    std::atomic_ref<double> suma(*args->suma_global);
+    suma.fetch_add(args->thread_data.suma_local, std::memory_order_relaxed);
 
     return nullptr;
 }
 
-double calcular_pi_mutex(long long n) {
-    pthread_t hilos[NUM_HILOS];
-    MutexArgs args[NUM_HILOS];
-    MutexData shared_data;
-
-    pthread_mutex_init(&shared_data.mutex, nullptr);
-    shared_data.suma_global = 0.0;
+double calcular_pi_atomic_ref(long long n, int num_hilos) {
+    alignas(std::atomic_ref<double>::required_alignment) double suma_global = 0.0;
+    std::vector<AtomicRefArgs> args(num_hilos);
+    for (AtomicRefArgs& a : args) a.suma_global = &suma_global;
 
-    for (int i = 0; i < NUM_HILOS; i++) {
-        args[i].thread_data.id = i;
-        args[i].thread_data.n_terminos = n;
-        args[i].shared_data = &shared_data;
-        pthread_create(&hilos[i], nullptr, thread_mutex, &args[i]);
-    }
+    lanzar_hilos(args, n, thread_atomic_ref);
 
-    for (int i = 0; i < NUM_HILOS; i++) {
-        pthread_join(hilos[i], nullptr);
-    }
+    return 4.0 * suma_global;
+}
 
-    pthread_mutex_destroy(&shared_data.mutex);
+// ============================================
+// 10. PARALLEL_REDUCE DEL POOL
+// ============================================
+// Los parciales se combinan en orden de hilo. Usa siempre el pool, también
+// con Lanzamiento::PorLlamada.
+double calcular_pi_parallel_reduce(long long n, int num_hilos) {
+    return 4.0 * parallel_reduce<OrderedCombine>(0LL, n, num_hilos, 0.0, sumar_serie, std::plus<double>());
+}
 
-    return 4.0 * shared_data.suma_global;
+// ============================================
+// 11. WORK STEALING
+// ============================================
+// Los mismos bloques que PARALLEL_REDUCE, pero partidos en trozos que un
+// hilo que terminó antes le roba a otro (comun/work_stealing.hpp)
+double calcular_pi_work_stealing(long long n, int num_hilos) {
+    double suma = default_stealer().parallel_reduce(0LL, n, num_hilos, 0, 0.0, sumar_serie, std::plus<double>());
+    return 4.0 * suma;
 }
 
 // ============================================
 // FUNCIONES PARA ANÁLISIS
 // ============================================
 
+// Estrategia paralela: (términos, hilos) -> pi
+typedef double (*CalculoPi)(long long, int);
+
 struct Resultado {
     std::string nombre;
     double pi_calculado;
     double tiempo;
     double error;
     double speedup;
+    int hilos;
+    long long terminos;
 };
 
 void guardar_resultados_csv(const std::vector<Resultado>& resultados, const std::string& filename) {
@@ -246,15 +571,18 @@ void guardar_resultados_csv(const std::vector<Resultado>& resultados, const std:
     }
 
     // Encabezado CSV
-    file << "Estrategia,Pi_Calculado,Tiempo_s,Error,Speedup\n";
+    file << "Estrategia,Pi_Calculado,Tiempo_s,Error,Speedup,Hilos,Eficiencia,Terminos_s\n";
 
     // Datos
     for (const auto& res : resultados) {
         file << res.nombre << ","
              << std::fixed << std::setprecision(15) << res.pi_calculado << ","
              << std::setprecision(6) << res.tiempo << ","
-             << res.error << ","
-             << res.speedup << "\n";
+             << std::scientific << res.error << std::fixed << ","
+             << res.speedup << ","
+             << res.hilos << ","
+             << res.speedup / res.hilos << ","
+             << std::scientific << std::setprecision(4) << res.terminos / res.tiempo << "\n";
     }
 
     file.close();
@@ -271,7 +599,8 @@ void imprimir_tabla_comparativa(const std::vector<Resultado>& resultados) {
               << std::setw(15) << "TIEMPO (s)"
               << std::setw(15) << "ERROR"
               << std::setw(15) << "SPEEDUP"
-              << std::setw(25) << "EFICIENCIA" << "\n";
+              << std::setw(15) << "EFICIENCIA"
+              << std::setw(15) << "TERMINOS/s" << "\n";
 
     std::cout << std::string(120, '-') << "\n";
 
@@ -281,13 +610,35 @@ void imprimir_tabla_comparativa(const std::vector<Resultado>& resultados) {
                   << std::setw(20) << res.pi_calculado
                   << std::setprecision(6)
                   << std::setw(15) << res.tiempo
+                  << std::scientific << std::setprecision(3)
                   << std::setw(15) << res.error
+                  << std::fixed << std::setprecision(6)
                   << std::setw(15) << res.speedup
-                  << std::setw(25) << (res.speedup / NUM_HILOS * 100) << "%\n";
+                  << std::setw(13) << (res.speedup / res.hilos * 100) << "% "
+                  << std::scientific << std::setprecision(3)
+                  << std::setw(15) << res.terminos / res.tiempo << "\n";
     }
     std::cout << std::string(120, '=') << "\n";
 }
 
+// Entre las estrategias paralelas, la más rápida y cuánto le cuesta la
+// combinación a cada una respecto de ella
+void imprimir_combinacion_mas_barata(const std::vector<Resultado>& resultados) {
+    const Resultado* mejor = nullptr;
+    for (const auto& res : resultados) {
+        if (res.nombre == "SECUENCIAL") continue;
+        if (!mejor || res.tiempo < mejor->tiempo) mejor = &res;
+    }
+    if (!mejor) return;
+
+    std::cout << "\nCombinacion mas barata con " << mejor->hilos << " hilos: " << mejor->nombre << "\n";
+    for (const auto& res : resultados) {
+        if (res.nombre == "SECUENCIAL" || &res == mejor) continue;
+        std::cout << "  " << std::left << std::setw(23) << res.nombre << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(8) << res.tiempo / mejor->tiempo << "x el tiempo\n";
+    }
+}
+
 void generar_grafico_ascii_tiempos(const std::vector<Resultado>& resultados) {
     std::cout << "\nGRAFICO DE TIEMPOS DE EJECUCION\n";
     std::cout << "==========================================\n";
@@ -324,14 +675,519 @@ void generar_grafico_ascii_speedup(const std::vector<Resultado>& resultados) {
     }
 }
 
+// ============================================
+// ROOFLINE (--roofline)
+// ============================================
+// Cada término hace una división y una suma (2 FLOPs). Las sumas parciales
+// viven en registros: el único tráfico es la escritura de cada suma local en
+// la compartida, salvo en BUSY-WAITING DENTRO, que por término lee y escribe
+// suma_global y flag (32 bytes), y en RANURAS, que leen y escriben la ranura
+// (16 bytes).
+RooflinePoint punto_roofline(const Resultado& res, long long n) {
+    double bytes;
+    if (res.nombre == "SECUENCIAL")
+        bytes = sizeof(double);
+    else if (res.nombre == "BUSY-WAITING_DENTRO")
+        bytes = 4.0 * sizeof(double) * n;
+    else if (res.nombre.rfind("RANURAS", 0) == 0)
+        bytes = 2.0 * sizeof(double) * n;
+    else
+        bytes = 2.0 * sizeof(double) * res.hilos;
+
+    RooflinePoint p;
+    p.name = res.nombre;
+    p.flops = 2.0 * n;
+    p.bytes = bytes;
+    p.seconds = res.tiempo;
+    return p;
+}
+
+void generar_roofline(const std::vector<Resultado>& resultados, int num_hilos) {
+    std::cout << "\nMidiendo techos de la maquina con " << num_hilos << " hilos...\n";
+    Ceilings techos = probe_ceilings(num_hilos);
+    print_ceilings(techos);
+
+    std::vector<RooflinePoint> puntos;
+    for (const auto& res : resultados)
+        puntos.push_back(punto_roofline(res, res.terminos));
+
+    print_roofline_chart(puntos, techos);
+    print_roofline_bars(puntos, techos);
+    write_roofline_csv(puntos, techos, "roofline_pi.csv");
+}
+
+// ============================================
+// ESCALADO (--escalado [fuerte|debil])
+// ============================================
+// Cada estrategia paralela con 1..max_hilos hilos a partir de `base`
+// términos con 1 hilo. Fuerte: base fijos; débil: base por hilo, base * p
+// en total.
+ScalingSeries medir_escalado(const std::string& nombre, CalculoPi calcular, long long base,
+                             ScalingMode modo, int max_hilos) {
+    ScalingSeries serie;
+    serie.name = nombre;
+    serie.mode = modo;
+    for (int hilos : scaling_thread_counts(max_hilos)) {
+        long long n = modo == ScalingMode::Strong ? base : base * hilos;
+        double pi = 0.0;
+        double tiempo = run_benchmark(nombre + "/" + scaling_mode_name(modo) + "/hilos=" + std::to_string(hilos),
+                                      [&]() { pi = calcular(n, hilos); }).median;
+        do_not_optimize(pi);
+        serie.points.push_back({hilos, static_cast<double>(n), tiempo});
+    }
+    return serie;
+}
+
+void generar_escalado(const std::string& modos, int max_hilos) {
+    std::vector<ScalingSeries> series;
+    for (ScalingMode modo : {ScalingMode::Strong, ScalingMode::Weak}) {
+        if (modos != "ambos" && modos != scaling_mode_name(modo)) continue;
+        std::cout << "\nEscalado " << scaling_mode_name(modo) << " con 1.." << max_hilos << " hilos...\n";
+        series.push_back(medir_escalado("BUSY-WAITING_DENTRO", calcular_pi_busy_waiting_dentro<EsperaSpin>,
+                                        TERMINOS_BW_DENTRO, modo, max_hilos));
+        series.push_back(medir_escalado("BUSY-WAITING_FUERA", calcular_pi_busy_waiting_fuera<EsperaSpin>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("BUSY-WAITING_FUERA_PAUSA", calcular_pi_busy_waiting_fuera<EsperaPausa>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("BUSY-WAITING_FUERA_YIELD", calcular_pi_busy_waiting_fuera<EsperaYield>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("BUSY-WAITING_FUERA_WAIT", calcular_pi_busy_waiting_fuera<EsperaAtomica>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("MUTEX", calcular_pi_mutex<PthreadMutexLock>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("MUTEX_TTAS", calcular_pi_mutex<TtasLock>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("MUTEX_TICKET", calcular_pi_mutex<TicketLock>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("MUTEX_MCS", calcular_pi_mutex<McsLock>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("MUTEX_FUTEX", calcular_pi_mutex<FutexLock>, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("ATOMIC_CAS", calcular_pi_atomic_cas, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("RANURAS_SIN_RELLENO", calcular_pi_ranuras_sin_relleno, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("RANURAS_CON_RELLENO", calcular_pi_ranuras_con_relleno, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("ARBOL", calcular_pi_arbol, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("ATOMIC_REF", calcular_pi_atomic_ref, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("PARALLEL_REDUCE", calcular_pi_parallel_reduce, NUM_TERMINOS, modo, max_hilos));
+        series.push_back(medir_escalado("WORK_STEALING", calcular_pi_work_stealing, NUM_TERMINOS, modo, max_hilos));
+    }
+
+    std::cout << "\nESCALADO FUERTE (Amdahl) Y DEBIL (Gustafson)\n";
+    print_scaling_table(series);
+    write_scaling_csv(series, "escalado_pi.csv");
+}
+
+// ============================================
+// POOL vs PTHREAD_CREATE POR LLAMADA (--pool)
+// ============================================
+// Tiempo por llamada según el número de términos, con los hilos del pool y
+// creándolos en cada llamada. Con pocos términos el costo es el lanzamiento:
+// la columna SECUENCIAL marca desde qué tamaño conviene paralelizar.
+void generar_comparacion_pool(int num_hilos) {
+    const std::pair<const char*, CalculoPi> estrategias[] = {
+        {"MUTEX", calcular_pi_mutex<PthreadMutexLock>},
+        {"ARBOL", calcular_pi_arbol},
+        {"ATOMIC_REF", calcular_pi_atomic_ref},
+    };
+
+    std::ofstream csv("pool_pi.csv");
+    csv << "Estrategia,Terminos,Hilos,Secuencial_us,Pool_us,PorLlamada_us\n";
+
+    std::cout << "\nPOOL vs PTHREAD_CREATE POR LLAMADA (" << num_hilos << " hilos, us por llamada)\n";
+    std::cout << std::left << std::setw(14) << "ESTRATEGIA" << std::right << std::setw(10) << "TERMINOS"
+              << std::setw(13) << "SECUENCIAL" << std::setw(12) << "POOL" << std::setw(16) << "PTHREAD_CREATE"
+              << std::setw(10) << "RAZON" << "\n";
+    std::cout << std::string(75, '-') << "\n";
+
+    for (long long n = 100; n <= NUM_TERMINOS; n *= 10) {
+        double pi = 0.0;
+        const std::string sufijo = std::string("/n=").append(std::to_string(n));
+        double secuencial = run_benchmark("SECUENCIAL" + sufijo, [&]() {
+            pi = calcular_pi_secuencial(n);
+        }).median;
+        do_not_optimize(pi);
+
+        for (const auto& [nombre, calcular] : estrategias) {
+            // Se restaura el modo pedido (--sin-pool) para lo que corre después
+            const Lanzamiento anterior = lanzamiento;
+            double tiempos[2];
+            for (Lanzamiento modo : {Lanzamiento::Pool, Lanzamiento::PorLlamada}) {
+                lanzamiento = modo;
+                tiempos[modo == Lanzamiento::Pool ? 0 : 1] =
+                    run_benchmark(nombre + sufijo + "/" + nombre_lanzamiento(modo), [&]() {
+                        pi = calcular(n, num_hilos);
+                    }).median;
+                do_not_optimize(pi);
+            }
+            lanzamiento = anterior;
+
+            std::cout << std::left << std::setw(14) << nombre << std::right << std::setw(10) << n
+                      << std::fixed << std::setprecision(2) << std::setw(13) << secuencial * 1e6
+                      << std::setw(12) << tiempos[0] * 1e6 << std::setw(16) << tiempos[1] * 1e6
+                      << std::setw(9) << tiempos[1] / tiempos[0] << "x\n";
+            csv << nombre << "," << n << "," << num_hilos << "," << secuencial * 1e6 << ","
+                << tiempos[0] * 1e6 << "," << tiempos[1] * 1e6 << "\n";
+        }
+    }
+    std::cout << "RAZON: tiempo con pthread_create / tiempo con el pool\n";
+    std::cout << "Resultados guardados en: pool_pi.csv\n";
+}
+
+// ============================================
+// DESBALANCE DE CARGA (--desbalance)
+// ============================================
+// Reparto estático contra robo de trabajo, sin carga y con un hilo que gira
+// fijo en la CPU 0: el hilo del kernel que comparte esa CPU avanza más
+// despacio y, con reparto estático, todos lo esperan.
+void generar_desbalance(int num_hilos) {
+    const std::pair<const char*, CalculoPi> estrategias[] = {
+        {"MUTEX", calcular_pi_mutex<PthreadMutexLock>},
+        {"PARALLEL_REDUCE", calcular_pi_parallel_reduce},
+        {"WORK_STEALING", calcular_pi_work_stealing},
+    };
+
+    std::ofstream csv("desbalance_pi.csv");
+    csv << "Carga,Estrategia,Hilos,Tiempo_s,Robos,Trozos\n";
+
+    std::cout << "\nDESBALANCE: REPARTO ESTATICO vs ROBO DE TRABAJO (" << num_hilos << " hilos)\n";
+    std::cout << std::left << std::setw(12) << "CARGA" << std::setw(18) << "ESTRATEGIA" << std::right
+              << std::setw(12) << "TIEMPO (s)" << std::setw(12) << "vs SIN" << std::setw(10) << "ROBOS"
+              << std::setw(10) << "TROZOS" << "\n";
+    std::cout << std::string(74, '-') << "\n";
+
+    double sin_carga[3] = {};
+    for (bool con_carga : {false, true}) {
+        std::unique_ptr<BusySpinner> spinner;
+        if (con_carga) spinner = std::make_unique<BusySpinner>(0);
+        const char* carga = con_carga ? "spinner" : "ninguna";
+
+        for (int e = 0; e < 3; e++) {
+            const auto& [nombre, calcular] = estrategias[e];
+            double pi = 0.0;
+            double tiempo = run_benchmark(std::string(nombre).append("/carga=").append(carga), [&]() {
+                pi = calcular(NUM_TERMINOS, num_hilos);
+            }).median;
+            do_not_optimize(pi);
+            if (!con_carga) sin_carga[e] = tiempo;
+
+            const bool robo = calcular == calcular_pi_work_stealing;
+            const StealStats& stats = default_stealer().last_stats();
+            std::cout << std::left << std::setw(12) << carga << std::setw(18) << nombre << std::right
+                      << std::fixed << std::setprecision(6) << std::setw(12) << tiempo
+                      << std::setprecision(2) << std::setw(11) << tiempo / sin_carga[e] << "x";
+            if (robo) std::cout << std::setw(10) << stats.steals << std::setw(10) << stats.chunks;
+            else std::cout << std::setw(10) << "-" << std::setw(10) << num_hilos;
+            std::cout << "\n";
+            csv << carga << "," << nombre << "," << num_hilos << "," << tiempo << ","
+                << (robo ? stats.steals : 0) << "," << (robo ? stats.chunks : num_hilos) << "\n";
+        }
+    }
+    std::cout << "ROBOS y TROZOS: de la ultima llamada medida\n";
+    std::cout << "Resultados guardados en: desbalance_pi.csv\n";
+}
+
+// ============================================
+// REPARTO Y COMBINACIÓN (--particion)
+// ============================================
+// parallel_reduce con cada reparto y cada combinador. Cíclico llama a
+// sumar_serie con un término por vez: sin pares que vectorizar, mide el
+// costo de repartir de a un elemento. Guiado sale de un contador
+// compartido, así que qué trozos toca cada hilo cambia entre llamadas.
+template <typename Combinador>
+double medir_particion(Partition reparto, int num_hilos, double referencia, std::ofstream& csv) {
+    double pi = 0.0;
+    const double tiempo = run_benchmark(std::string("particion/").append(partition_name(reparto))
+                                            .append("/").append(Combinador::name), [&]() {
+        pi = 4.0 * parallel_reduce<Combinador>(0LL, NUM_TERMINOS, num_hilos, 0.0, sumar_serie,
+                                               std::plus<double>(), Partitioning{reparto, 0}, lanzador);
+    }).median;
+    do_not_optimize(pi);
+    if (referencia <= 0.0) referencia = tiempo;
+
+    std::cout << std::left << std::setw(16) << partition_name(reparto) << std::setw(10) << Combinador::name
+              << std::right << std::fixed << std::setprecision(6) << std::setw(12) << tiempo
+              << std::setprecision(2) << std::setw(11) << tiempo / referencia << "x" << std::scientific
+              << std::setprecision(3) << std::setw(12) << std::abs(pi - PI_REAL) << std::defaultfloat << "\n";
+    csv << partition_name(reparto) << "," << Combinador::name << "," << num_hilos << "," << tiempo << ","
+        << std::abs(pi - PI_REAL) << "\n";
+    return tiempo;
+}
+
+void generar_particion(int num_hilos) {
+    std::ofstream csv("particion_pi.csv");
+    csv << "Reparto,Combinacion,Hilos,Tiempo_s,Error\n";
+
+    std::cout << "\nPARALLEL_REDUCE: REPARTO x COMBINACION (" << num_hilos << " hilos)\n";
+    std::cout << std::left << std::setw(16) << "REPARTO" << std::setw(10) << "COMBINA" << std::right
+              << std::setw(12) << "TIEMPO (s)" << std::setw(12) << "vs BLOQUE" << std::setw(12) << "ERROR" << "\n";
+    std::cout << std::string(62, '-') << "\n";
+
+    double referencia = 0.0;
+    for (Partition reparto : {Partition::Block, Partition::Cyclic, Partition::BlockCyclic, Partition::Guided}) {
+        const double t = medir_particion<OrderedCombine>(reparto, num_hilos, referencia, csv);
+        if (referencia <= 0.0) referencia = t;
+        medir_particion<LockCombine<PthreadMutexLock>>(reparto, num_hilos, referencia, csv);
+        medir_particion<AtomicCombine>(reparto, num_hilos, referencia, csv);
+        medir_particion<TreeCombine>(reparto, num_hilos, referencia, csv);
+        medir_particion<CombinarEnTurno<EsperaAtomica>>(reparto, num_hilos, referencia, csv);
+        std::cout << std::string(62, '-') << "\n";
+    }
+    std::cout << "vs BLOQUE: tiempo / tiempo de bloque con combinacion ordenada\n";
+    std::cout << "Resultados guardados en: particion_pi.csv\n";
+}
+
+// ============================================
+// KERNEL DE LA SERIE (--serie)
+// ============================================
+// Los tres modos de sumar_serie en un hilo. Error contra PI_REAL y error de
+// redondeo: lo que queda al descontar el truncamiento de la serie,
+//   pi - 4 S_n = (-1)^n (1/n - 1/(4n^3)) + O(1/n^5)
+// que con 10^7 términos (1e-7) tapa a todo el redondeo.
+void generar_comparacion_serie() {
+    std::ofstream csv("serie_pi.csv");
+    csv << "Modo,Terminos,Tiempo_s,Terminos_s,Error,Error_redondeo\n";
+
+    std::cout << "\nKERNEL DE LA SERIE (1 hilo, variante " << isa_name(active_isa()) << ")\n";
+    std::cout << std::left << std::setw(13) << "MODO" << std::right << std::setw(12) << "TERMINOS"
+              << std::setw(13) << "TIEMPO (s)" << std::setw(13) << "TERMINOS/s" << std::setw(13) << "ERROR"
+              << std::setw(15) << "ERROR REDONDEO" << "\n";
+    std::cout << std::string(79, '-') << "\n";
+
+    const ModoSuma modo_original = modo_suma;
+    for (long long n = 1000000; n <= 100000000; n *= 10) {
+        const double dn = static_cast<double>(n);
+        const double truncamiento = (n % 2 == 0 ? 1.0 : -1.0) * (1.0 / dn - 1.0 / (4.0 * dn * dn * dn));
+        for (ModoSuma modo : {ModoSuma::Escalar, ModoSuma::Vectorizada, ModoSuma::Compensada}) {
+            modo_suma = modo;
+            double pi = 0.0;
+            double tiempo = run_benchmark(std::string("serie/").append(nombre_modo_suma(modo))
+                                              .append("/n=").append(std::to_string(n)),
+                                          [&]() { pi = calcular_pi_secuencial(n); }).median;
+            const double error = std::abs(pi - PI_REAL);
+            const double redondeo = std::abs(pi - (PI_REAL - truncamiento));
+
+            std::cout << std::left << std::setw(13) << nombre_modo_suma(modo) << std::right
+                      << std::setw(12) << n << std::fixed << std::setprecision(6) << std::setw(13) << tiempo
+                      << std::scientific << std::setprecision(3) << std::setw(13) << n / tiempo
+                      << std::setw(13) << error << std::setw(15) << redondeo << "\n";
+            csv << nombre_modo_suma(modo) << "," << n << "," << tiempo << "," << n / tiempo << ","
+                << error << "," << redondeo << "\n";
+        }
+    }
+    modo_suma = modo_original;
+    std::cout << "Resultados guardados en: serie_pi.csv\n";
+}
+
+// ============================================
+// CONTENCIÓN DE LOCKS (--locks)
+// ============================================
+// Cada hilo toma el lock, hace `largo` operaciones dependientes sobre un
+// dato compartido, lo suelta y repite hasta que pasan CONTENCION_MS.
+// Throughput: adquisiciones por segundo entre todos los hilos. Equidad:
+// índice de Jain de las adquisiciones por hilo, (suma x)^2 / (p suma x^2),
+// que vale 1 si todos tomaron el lock las mismas veces y 1/p si lo tomó uno
+// solo, y la razón entre el hilo que menos y el que más lo tomó.
+constexpr int CONTENCION_MS = 50;
+
+struct alignas(64) CuentaHilo {
+    long long adquisiciones;
+};
+
+template <typename Lock>
+void medir_contencion(int hilos, int largo, std::ofstream& csv) {
+    Lock lock;
+    double compartido = 0.0;
+    std::vector<CuentaHilo> cuentas(hilos);
+
+    const auto inicio = std::chrono::steady_clock::now();
+    const auto fin = inicio + std::chrono::milliseconds(CONTENCION_MS);
+    default_pool().run(hilos, [&](int id) {
+        typename Lock::Node nodo;
+        long long n = 0;
+        for (;;) {
+            lock.lock(nodo);
+            for (int k = 0; k < largo; k++) compartido = compartido * 0.999999 + 1.0;
+            lock.unlock(nodo);
+            ++n;
+            if (n % 16 == 0 && std::chrono::steady_clock::now() >= fin) break;
+        }
+        cuentas[id].adquisiciones = n;
+    });
+    const double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    do_not_optimize(compartido);
+
+    double total = 0.0, cuadrados = 0.0;
+    long long minimo = cuentas[0].adquisiciones, maximo = minimo;
+    for (const CuentaHilo& c : cuentas) {
+        total += c.adquisiciones;
+        cuadrados += double(c.adquisiciones) * c.adquisiciones;
+        minimo = std::min(minimo, c.adquisiciones);
+        maximo = std::max(maximo, c.adquisiciones);
+    }
+    const double jain = total * total / (hilos * cuadrados);
+
+    std::cout << std::left << std::setw(10) << Lock::name << std::right << std::setw(7) << hilos
+              << std::setw(8) << largo << std::fixed << std::setprecision(3) << std::setw(14)
+              << total / segundos / 1e6 << std::setw(10) << jain << std::setw(10)
+              << double(minimo) / maximo << "\n";
+    csv << Lock::name << "," << hilos << "," << largo << "," << total / segundos << "," << jain << ",";
+    for (int h = 0; h < hilos; h++) csv << (h ? ";" : "") << cuentas[h].adquisiciones;
+    csv << "\n";
+}
+
+void generar_contencion(int max_hilos) {
+    std::vector<int> hilos_probados;
+    for (int h = 1; h < max_hilos; h *= 2) hilos_probados.push_back(h);
+    hilos_probados.push_back(max_hilos);
+
+    std::ofstream csv("locks_pi.csv");
+    csv << "Lock,Hilos,Largo,Adquisiciones_s,Jain,Por_hilo\n";
+
+    std::cout << "\nCONTENCION DE LOCKS (" << CONTENCION_MS << " ms por caso; largo = operaciones"
+              << " dependientes dentro de la seccion critica)\n";
+    std::cout << std::left << std::setw(10) << "LOCK" << std::right << std::setw(7) << "HILOS"
+              << std::setw(8) << "LARGO" << std::setw(14) << "M ADQ/s" << std::setw(10) << "JAIN"
+              << std::setw(10) << "MIN/MAX" << "\n";
+    std::cout << std::string(59, '-') << "\n";
+
+    for (int largo : {0, 10, 100, 1000}) {
+        for (int hilos : hilos_probados) {
+            medir_contencion<PthreadMutexLock>(hilos, largo, csv);
+            medir_contencion<TtasLock>(hilos, largo, csv);
+            medir_contencion<TicketLock>(hilos, largo, csv);
+            medir_contencion<McsLock>(hilos, largo, csv);
+            medir_contencion<FutexLock>(hilos, largo, csv);
+        }
+        std::cout << std::string(59, '-') << "\n";
+    }
+    std::cout << "Resultados guardados en: locks_pi.csv (adquisiciones de cada hilo en Por_hilo)\n";
+}
+
+// ============================================
+// PASO DEL TURNO (--espera)
+// ============================================
+// Solo el protocolo de turnos, sin términos: cada hilo espera su turno y
+// se lo pasa al siguiente hasta que pasan ESPERA_MS. Latencia: tiempo de
+// pared por traspaso. CPU: tiempo de CPU de todo el proceso (todos los
+// hilos) por traspaso y en núcleos ocupados en promedio; una espera que
+// gira ocupa un núcleo por hilo aunque no avance. Se prueba con más hilos
+// que núcleos, donde el siguiente en turno puede no estar corriendo.
+constexpr int ESPERA_MS = 100;
+
+double segundos_cpu_proceso() {
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+template <typename Espera>
+void medir_paso_turno(int hilos, int nucleos, std::ofstream& csv) {
+    BusyWaitData shared;
+    shared.flag.store(0, std::memory_order_relaxed);
+    shared.suma_global = 0.0;
+    long long traspasos = 0;   // lo incrementa quien tiene el turno
+    bool terminado = false;    // idem; el turno lo publica
+
+    const auto inicio = std::chrono::steady_clock::now();
+    const auto fin = inicio + std::chrono::milliseconds(ESPERA_MS);
+    const double cpu_inicio = segundos_cpu_proceso();
+    default_pool().run(hilos, [&](int id) {
+        for (;;) {
+            Espera::esperar(shared.flag, id);
+            const bool salir = terminado;
+            if (!salir && ++traspasos % 64 == 0 && std::chrono::steady_clock::now() >= fin) terminado = true;
+            shared.flag.store((id + 1) % hilos, std::memory_order_release);
+            Espera::notificar(shared.flag);
+            // Tras ver terminado cada hilo pasa el turno una vez más y sale
+            if (salir || terminado) break;
+        }
+    });
+    const double pared = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    const double cpu = segundos_cpu_proceso() - cpu_inicio;
+
+    std::cout << std::left << std::setw(8) << Espera::nombre << std::right << std::setw(7) << hilos
+              << std::setw(7) << (hilos > nucleos ? "si" : "no") << std::setw(12) << traspasos
+              << std::fixed << std::setprecision(1) << std::setw(14) << pared / traspasos * 1e9
+              << std::setw(14) << cpu / traspasos * 1e9 << std::setprecision(2) << std::setw(12)
+              << cpu / pared << "\n";
+    csv << Espera::nombre << "," << hilos << "," << nucleos << "," << traspasos << "," << pared / traspasos * 1e9
+        << "," << cpu / traspasos * 1e9 << "," << cpu / pared << "\n";
+}
+
+void generar_paso_turno() {
+    const int nucleos = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> hilos_probados = {2, 4, nucleos, 2 * nucleos};
+    std::sort(hilos_probados.begin(), hilos_probados.end());
+    hilos_probados.erase(std::unique(hilos_probados.begin(), hilos_probados.end()), hilos_probados.end());
+    hilos_probados.erase(std::remove_if(hilos_probados.begin(), hilos_probados.end(),
+                                        [](int h) { return h < 2; }), hilos_probados.end());
+
+    std::ofstream csv("espera_pi.csv");
+    csv << "Espera,Hilos,Nucleos,Traspasos,Latencia_ns,CPU_ns_por_traspaso,Nucleos_ocupados\n";
+
+    std::cout << "\nPASO DEL TURNO (" << ESPERA_MS << " ms por caso, " << nucleos << " nucleos)\n";
+    std::cout << std::left << std::setw(8) << "ESPERA" << std::right << std::setw(7) << "HILOS"
+              << std::setw(7) << "SOBRE" << std::setw(12) << "TRASPASOS" << std::setw(14) << "LATENCIA ns"
+              << std::setw(14) << "CPU ns" << std::setw(12) << "NUCLEOS" << "\n";
+    std::cout << std::string(74, '-') << "\n";
+    for (int hilos : hilos_probados) {
+        medir_paso_turno<EsperaSpin>(hilos, nucleos, csv);
+        medir_paso_turno<EsperaPausa>(hilos, nucleos, csv);
+        medir_paso_turno<EsperaYield>(hilos, nucleos, csv);
+        medir_paso_turno<EsperaAtomica>(hilos, nucleos, csv);
+        std::cout << std::string(74, '-') << "\n";
+    }
+    std::cout << "SOBRE: mas hilos que nucleos; NUCLEOS: tiempo de CPU / tiempo de pared\n";
+    std::cout << "Resultados guardados en: espera_pi.csv\n";
+}
+
 // ============================================
 // MAIN PRINCIPAL
 // ============================================
-int main() {
+int main(int argc, char* argv[]) {
+    bool roofline = false;
+    bool comparar_pool = false;
+    bool desbalance = false;
+    bool particion = false;
+    bool comparar_serie = false;
+    bool contencion = false;
+    bool paso_turno = false;
+    std::string escalado;  // vacío: sin barrido de hilos
+    int num_hilos = NUM_HILOS;
+    int max_hilos = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg == "--roofline") {
+            roofline = true;
+        } else if (arg == "--pool") {
+            comparar_pool = true;
+        } else if (arg == "--espera") {
+            paso_turno = true;
+        } else if (arg == "--locks") {
+            contencion = true;
+        } else if (arg == "--serie") {
+            comparar_serie = true;
+        } else if (arg == "--suma" && a + 1 < argc && leer_modo_suma(argv[a + 1], modo_suma)) {
+            a++;
+        } else if (arg == "--desbalance") {
+            desbalance = true;
+        } else if (arg == "--particion") {
+            particion = true;
+        } else if (arg == "--sin-pool") {
+            lanzamiento = Lanzamiento::PorLlamada;
+        } else if (arg == "--hilos" && a + 1 < argc) {
+            num_hilos = std::max(1, std::atoi(argv[++a]));
+        } else if (arg == "--max-hilos" && a + 1 < argc) {
+            max_hilos = std::max(1, std::atoi(argv[++a]));
+        } else if (arg == "--escalado") {
+            escalado = "ambos";
+            if (a + 1 < argc && (std::string(argv[a + 1]) == "fuerte" || std::string(argv[a + 1]) == "debil"))
+                escalado = argv[++a];
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--hilos N] [--roofline] [--pool] [--sin-pool] [--desbalance] [--particion]"
+                      << " [--suma escalar|vectorizada|compensada] [--serie] [--locks] [--espera]"
+                      << " [--escalado [fuerte|debil]] [--max-hilos N]\n";
+            return 1;
+        }
+    }
+
     std::cout << "=================================================\n"
               << "    ANALISIS COMPARATIVO: ESTRATEGIAS PI\n"
               << "=================================================\n"
-              << "Terminos: " << NUM_TERMINOS << " | Hilos: " << NUM_HILOS << "\n"
+              << "Terminos: " << NUM_TERMINOS << " | Hilos: " << num_hilos
+              << " | Lanzamiento: " << nombre_lanzamiento(lanzamiento)
+              << " | Suma: " << nombre_modo_suma(modo_suma) << "\n"
               << "pi real: " << std::fixed << std::setprecision(15) << PI_REAL << "\n"
               << "=================================================\n\n";
 
@@ -340,9 +1196,10 @@ int main() {
 
     // 1. SECUENCIAL
     std::cout << "Ejecutando calculo SECUENCIAL...\n";
-    Timer timer;
-    double pi_secuencial = calcular_pi_secuencial(NUM_TERMINOS);
-    double tiempo_secuencial = timer.elapsed();
+    double pi_secuencial = 0.0;
+    double tiempo_secuencial = run_benchmark("SECUENCIAL", [&]() {
+        pi_secuencial = calcular_pi_secuencial(NUM_TERMINOS);
+    }).median;
     tiempo_base = tiempo_secuencial;
 
     resultados.push_back({
@@ -350,55 +1207,72 @@ int main() {
         pi_secuencial,
         tiempo_secuencial,
         std::abs(pi_secuencial - PI_REAL),
-        1.0
+        1.0,
+        1,
+        NUM_TERMINOS
     });
 
     // 2. BUSY-WAITING DENTRO (solo para demostración con menos términos)
-    if (NUM_TERMINOS <= 100000) {
-        std::cout << "Ejecutando BUSY-WAITING DENTRO...\n";
-        timer = Timer();
-        double pi_bw_dentro = calcular_pi_busy_waiting_dentro(NUM_TERMINOS);
-        double tiempo_bw_dentro = timer.elapsed();
-
+    {
+        std::cout << "Ejecutando BUSY-WAITING DENTRO (" << TERMINOS_BW_DENTRO << " terminos)...\n";
+        double pi_bw_dentro = 0.0;
+        double tiempo_bw_dentro = run_benchmark("BUSY-WAITING_DENTRO", [&]() {
+            pi_bw_dentro = calcular_pi_busy_waiting_dentro<EsperaSpin>(TERMINOS_BW_DENTRO, num_hilos);
+        }).median;
+
+        // Speedup por término: el secuencial escalado a los mismos términos
+        // (su error sí es el de una serie más corta)
         resultados.push_back({
             "BUSY-WAITING_DENTRO",
             pi_bw_dentro,
             tiempo_bw_dentro,
             std::abs(pi_bw_dentro - PI_REAL),
-            tiempo_base / tiempo_bw_dentro
+            tiempo_base * TERMINOS_BW_DENTRO / NUM_TERMINOS / tiempo_bw_dentro,
+            num_hilos,
+            TERMINOS_BW_DENTRO
         });
     }
 
-    // 3. BUSY-WAITING FUERA
-    std::cout << "Ejecutando BUSY-WAITING FUERA...\n";
-    timer = Timer();
-    double pi_bw_fuera = calcular_pi_busy_waiting_fuera(NUM_TERMINOS);
-    double tiempo_bw_fuera = timer.elapsed();
-
-    resultados.push_back({
-        "BUSY-WAITING_FUERA",
-        pi_bw_fuera,
-        tiempo_bw_fuera,
-        std::abs(pi_bw_fuera - PI_REAL),
-        tiempo_base / tiempo_bw_fuera
-    });
-
-    // 4. MUTEX
-    std::cout << "Ejecutando MUTEX...\n";
-    timer = Timer();
-    double pi_mutex = calcular_pi_mutex(NUM_TERMINOS);
-    double tiempo_mutex = timer.elapsed();
+    // 3-11. ESTRATEGIAS CON SUMA LOCAL POR HILO
+    const std::pair<const char*, CalculoPi> estrategias[] = {
+        {"BUSY-WAITING_FUERA", calcular_pi_busy_waiting_fuera<EsperaSpin>},
+        {"BUSY-WAITING_FUERA_PAUSA", calcular_pi_busy_waiting_fuera<EsperaPausa>},
+        {"BUSY-WAITING_FUERA_YIELD", calcular_pi_busy_waiting_fuera<EsperaYield>},
+        {"BUSY-WAITING_FUERA_WAIT", calcular_pi_busy_waiting_fuera<EsperaAtomica>},
+        {"MUTEX", calcular_pi_mutex<PthreadMutexLock>},
+        {"MUTEX_TTAS", calcular_pi_mutex<TtasLock>},
+        {"MUTEX_TICKET", calcular_pi_mutex<TicketLock>},
+        {"MUTEX_MCS", calcular_pi_mutex<McsLock>},
+        {"MUTEX_FUTEX", calcular_pi_mutex<FutexLock>},
+        {"ATOMIC_CAS", calcular_pi_atomic_cas},
+        {"RANURAS_SIN_RELLENO", calcular_pi_ranuras_sin_relleno},
+        {"RANURAS_CON_RELLENO", calcular_pi_ranuras_con_relleno},
+        {"ARBOL", calcular_pi_arbol},
+        {"ATOMIC_REF", calcular_pi_atomic_ref},
+        {"PARALLEL_REDUCE", calcular_pi_parallel_reduce},
+        {"WORK_STEALING", calcular_pi_work_stealing},
+    };
+    for (const auto& [nombre, calcular] : estrategias) {
+        std::cout << "Ejecutando " << nombre << "...\n";
+        double pi = 0.0;
+        double tiempo = run_benchmark(nombre, [&]() {
+            pi = calcular(NUM_TERMINOS, num_hilos);
+        }).median;
 
-    resultados.push_back({
-        "MUTEX",
-        pi_mutex,
-        tiempo_mutex,
-        std::abs(pi_mutex - PI_REAL),
-        tiempo_base / tiempo_mutex
-    });
+        resultados.push_back({
+            nombre,
+            pi,
+            tiempo,
+            std::abs(pi - PI_REAL),
+            tiempo_base / tiempo,
+            num_hilos,
+            NUM_TERMINOS
+        });
+    }
 
     // GENERAR REPORTES
     imprimir_tabla_comparativa(resultados);
+    imprimir_combinacion_mas_barata(resultados);
     generar_grafico_ascii_tiempos(resultados);
     generar_grafico_ascii_speedup(resultados);
 
@@ -407,5 +1281,30 @@ int main() {
 
     std::cout << "\nResultados guardados en 'resultados_pi.csv' para analisis con Python\n";
 
+    // POSICION DE CADA ESTRATEGIA RESPECTO A LOS TECHOS
+    if (roofline) generar_roofline(resultados, num_hilos);
+
+    // SPEEDUP CON 1..max_hilos HILOS
+    if (!escalado.empty()) generar_escalado(escalado, max_hilos);
+
+    // COSTO DE LANZAR LOS HILOS SEGUN EL TAMAÑO
+    if (comparar_pool) generar_comparacion_pool(num_hilos);
+
+    // REPARTO ESTATICO vs ROBO DE TRABAJO CON UN NUCLEO CARGADO
+    if (desbalance) generar_desbalance(num_hilos);
+
+    // REPARTOS Y COMBINADORES DE PARALLEL_REDUCE
+    if (particion) generar_particion(num_hilos);
+
+    // ESCALAR vs VECTORIZADA vs COMPENSADA
+    if (comparar_serie) generar_comparacion_serie();
+
+    // THROUGHPUT Y EQUIDAD DE CADA LOCK BAJO CONTENCION
+    if (contencion) generar_contencion(std::max(num_hilos, max_hilos));
+
+    // LATENCIA Y CPU DE CADA ESPERA AL PASAR EL TURNO
+    if (paso_turno) generar_paso_turno();
+    save_bench_report("implementacion");
+
     return 0;
 }
\ No newline at end of file
@@ -10,7 +10,7 @@ def ejecutar_cpp_y_obtener_datos():
 
     # Compilar
     compile_result = subprocess.run([
-        'g++', '-std=c++11', '-pthread', '-O2', 'pi_analisis.cpp', '-o', 'pi_analisis'
+        'g++', '-std=c++20', '-pthread', '-O2', 'implementacion.cpp', '-o', 'implementacion'
     ], capture_output=True, text=True)
 
     if compile_result.returncode != 0:
@@ -20,7 +20,7 @@ def ejecutar_cpp_y_obtener_datos():
 
     # Ejecutar
     print("🚀 Ejecutando cálculo de π...")
-    ejecucion_result = subprocess.run(['./pi_analisis'], capture_output=True, text=True)
+    ejecucion_result = subprocess.run(['./implementacion'], capture_output=True, text=True)
     print(ejecucion_result.stdout)
 
     if ejecucion_result.returncode != 0:
@@ -97,13 +97,14 @@ def crear_graficos_desde_datos_reales(df):
         ax3.text(bar.get_x() + bar.get_width()/2., height * 1.1,
                  f'{height:.2e}', ha='center', va='bottom', fontweight='bold', fontsize=9)
 
-    # Gráfico 4: Eficiencia de paralelización (asumiendo 4 hilos)
-    eficiencia = (df['Speedup'] / 4) * 100  # 4 hilos
+    # Gráfico 4: Eficiencia de paralelización (speedup / hilos de cada estrategia)
+    hilos = df['Hilos'] if 'Hilos' in df.columns else pd.Series(4, index=df.index)
+    eficiencia = (df['Speedup'] / hilos) * 100
     bars4 = ax4.bar(df['Estrategia'], eficiencia, color=colors, alpha=0.8, edgecolor='black')
-    ax4.set_title('EFICIENCIA DE PARALELIZACIÓN REAL\n(4 Hilos - Ideal: 25% por hilo)',
+    ax4.set_title(f'EFICIENCIA DE PARALELIZACIÓN REAL\n({hilos.max()} Hilos - Ideal: 100%)',
                   fontsize=14, fontweight='bold', pad=20)
     ax4.set_ylabel('Eficiencia (%)', fontweight='bold')
-    ax4.axhline(y=25, color='green', linestyle='--', alpha=0.7, label='Eficiencia base por hilo')
+    ax4.axhline(y=100, color='green', linestyle='--', alpha=0.7, label='Eficiencia ideal')
     ax4.tick_params(axis='x', rotation=45)
     ax4.grid(axis='y', alpha=0.3)
     ax4.legend()
@@ -169,6 +170,54 @@ def analizar_resultados_reales(df, eficiencia):
         print("   ⚠️  BUSY-WAITING_FUERA: Buen rendimiento pero consume CPU en espera")
     if 'BUSY-WAITING_DENTRO' in df['Estrategia'].values:
         print("   ❌ BUSY-WAITING_DENTRO: Evitar - serialización completa")
+    if 'BUSY-WAITING_FUERA_WAIT' in df['Estrategia'].values:
+        print("   ✅ BUSY-WAITING_FUERA_WAIT: Duerme en el futex; no gasta CPU con más hilos que núcleos")
+    if 'ATOMIC_CAS' in df['Estrategia'].values:
+        print("   ✅ ATOMIC_CAS: Sin lock; el costo crece con los reintentos del CAS")
+    if 'ATOMIC_REF' in df['Estrategia'].values:
+        print("   ✅ ATOMIC_REF: Igual que CAS pero sobre un double común (C++20)")
+    if 'ARBOL' in df['Estrategia'].values:
+        print("   ✅ ARBOL: Combinación en log2(hilos) rondas, para muchos hilos")
+    estrategias = df.set_index('Estrategia')['Tiempo_s']
+    if {'RANURAS_SIN_RELLENO', 'RANURAS_CON_RELLENO'} <= set(estrategias.index):
+        ratio = estrategias['RANURAS_SIN_RELLENO'] / estrategias['RANURAS_CON_RELLENO']
+        print(f"   ⚠️  RANURAS: sin relleno {ratio:.2f}x el tiempo con relleno (false sharing)")
+    paralelas = df[df['Estrategia'] != 'SECUENCIAL']
+    if not paralelas.empty:
+        mejor = paralelas.loc[paralelas['Tiempo_s'].idxmin()]
+        print(f"   🏁 Combinación más barata con {int(mejor['Hilos'])} hilos: {mejor['Estrategia']}")
+
+def graficar_escalado(archivo='escalado_pi.csv'):
+    """Speedup medido vs Amdahl (fuerte) y Gustafson (débil) desde ./implementacion --escalado"""
+    if not os.path.exists(archivo):
+        print(f"ℹ️  Sin {archivo}: ejecutar ./implementacion --escalado para generarlo")
+        return None
+
+    df = pd.read_csv(archivo)
+    modos = list(df['Modo'].unique())
+    fig, axes = plt.subplots(1, len(modos), figsize=(8 * len(modos), 6), squeeze=False)
+
+    for ax, modo in zip(axes[0], modos):
+        datos = df[df['Modo'] == modo]
+        for estrategia, serie in datos.groupby('Estrategia'):
+            linea, = ax.plot(serie['Hilos'], serie['Speedup'], 'o-', label=f'{estrategia} (medido)')
+            f = serie['Fraccion_Serial'].iloc[0]
+            if f >= 0:
+                ley = 'Amdahl' if modo == 'fuerte' else 'Gustafson'
+                ax.plot(serie['Hilos'], serie['Speedup_Modelo'], '--', color=linea.get_color(),
+                        label=f'{estrategia} ({ley}, f={f:.3f})')
+        hilos = datos['Hilos'].max()
+        ax.plot([1, hilos], [1, hilos], 'k:', alpha=0.5, label='Ideal')
+        ax.set_title(f'ESCALADO {modo.upper()}', fontsize=14, fontweight='bold')
+        ax.set_xlabel('Hilos', fontweight='bold')
+        ax.set_ylabel('Speedup (x)', fontweight='bold')
+        ax.grid(alpha=0.3)
+        ax.legend()
+
+    plt.tight_layout()
+    plt.savefig('escalado_pi.png', dpi=300, bbox_inches='tight')
+    plt.show()
+    return df
 
 # Ejecutar análisis completo
 if __name__ == "__main__":
@@ -182,6 +231,9 @@ if __name__ == "__main__":
         # Analizar resultados
         analizar_resultados_reales(df, eficiencia)
 
+        # Escalado con 1..nproc hilos (si se generó)
+        graficar_escalado()
+
         print(f"\n🎉 ANÁLISIS COMPLETADO CON DATOS REALES!")
         print(f"   - Gráficos guardados: comparativa_estrategias_reales.png")
         print(f"   - Datos crudos: resultados_pi.csv")